@@ -0,0 +1,122 @@
+#include "../src/util/rw_lock.hpp"
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <cstdio>
+#include <sys/resource.h>
+
+using namespace std::chrono;
+
+const unsigned int COUNT_WRITES = 10;
+const milliseconds DURATION_WRITE( 50 );
+const microseconds INTERVAL_READ( 200 );
+
+class SpinLock {
+    private:
+        std::atomic<unsigned int> _writers = 0;
+        std::shared_timed_mutex _m;
+
+    public:
+        void lock() {
+            _writers++;
+            _m.lock();
+        }
+
+        void unlock() {
+            _m.unlock();
+            _writers--;
+        }
+
+        void lock_shared() {
+            while( _writers != 0 ) {
+            }
+
+            _m.lock_shared();
+        }
+
+        void unlock_shared() {
+            _m.unlock_shared();
+        }
+};
+
+double getCpu() {
+    rusage usage;
+    getrusage( RUSAGE_SELF, &usage );
+
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + ( usage.ru_utime.tv_usec + usage.ru_stime.tv_usec ) / 1e6;
+}
+
+template<typename Lock>
+void run( const char *name, unsigned int countReaders ) {
+    Lock lock;
+    std::atomic<bool> isStop = false;
+    std::vector<std::vector<double>> waits( countReaders );
+    std::vector<std::thread> readers;
+    auto cpuStart = getCpu();
+    auto tStart = steady_clock::now();
+
+    for( unsigned int i = 0; i < countReaders; i++ ) {
+        readers.emplace_back( [&, i] {
+            while( !isStop ) {
+                auto t = steady_clock::now();
+
+                {
+                    std::shared_lock<Lock> lockRead( lock );
+                }
+
+                waits[i].push_back( duration<double, std::micro>( steady_clock::now() - t ).count() );
+                std::this_thread::sleep_for( INTERVAL_READ );
+            }
+        } );
+    }
+
+    for( unsigned int i = 0; i < COUNT_WRITES; i++ ) {
+        std::this_thread::sleep_for( DURATION_WRITE );
+        std::lock_guard<Lock> lockWrite( lock );
+        auto tEnd = steady_clock::now() + DURATION_WRITE;
+
+        while( steady_clock::now() < tEnd ) {
+        }
+    }
+
+    isStop = true;
+
+    for( auto &reader : readers ) {
+        reader.join();
+    }
+
+    auto wall = duration<double>( steady_clock::now() - tStart ).count();
+    auto cpu = getCpu() - cpuStart;
+    std::vector<double> all;
+
+    for( auto &wait : waits ) {
+        all.insert( all.end(), wait.begin(), wait.end() );
+    }
+
+    std::sort( all.begin(), all.end() );
+
+    printf(
+        "%-8s readers %-3u wall %.2fs cpu %.2fs reads %zu p50 %.1fus p99 %.1fus max %.1fms\n",
+        name,
+        countReaders,
+        wall,
+        cpu,
+        all.size(),
+        all[all.size() / 2],
+        all[all.size() * 99 / 100],
+        all.back() / 1e3
+    );
+}
+
+int main() {
+    printf( "one writer holds the lock %u x %ldms, readers lock shared every %ldus\n", COUNT_WRITES, DURATION_WRITE.count(), INTERVAL_READ.count() );
+
+    for( auto countReaders : { 4, 16 } ) {
+        run<SpinLock>( "spin", countReaders );
+        run<memsess::util::RWLock>( "RWLock", countReaders );
+    }
+}
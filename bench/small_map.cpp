@@ -0,0 +1,93 @@
+#include "../src/core/store.hpp"
+#include "../src/core/monitoring.hpp"
+#include "../src/util/policy.hpp"
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+using namespace memsess;
+
+typedef core::Monitoring<util::PolicyMulti> Monitoring;
+typedef core::Store<util::PolicyMulti, Monitoring> Store;
+
+const unsigned int COUNT_SESSIONS = 200'000;
+const unsigned int COUNT_SHARDS = 64;
+const unsigned int COUNT_QUERIES = 4'000'000;
+const char VALUE[] = "0123456789abcdef";
+
+long int getRss() {
+    long int pages = 0;
+    long int resident = 0;
+    auto file = fopen( "/proc/self/statm", "r" );
+
+    if( fscanf( file, "%ld %ld", &pages, &resident ) != 2 ) {
+        resident = 0;
+    }
+
+    fclose( file );
+
+    return resident * sysconf( _SC_PAGESIZE );
+}
+
+int main( int argc, char *argv[] ) {
+    unsigned int countKeys = argc > 1 ? atoi( argv[1] ) : 5;
+    Monitoring monitoring;
+    Store store( &monitoring, COUNT_SHARDS );
+    std::vector<Store::KeyId> keys;
+    std::vector<util::SessionId> sessions( COUNT_SESSIONS );
+    unsigned int counterKeys;
+    unsigned int counterRecord;
+
+    store.setLimit( 0 );
+
+    for( unsigned int i = 0; i < countKeys; i++ ) {
+        keys.push_back( store.getKeyId( "key_" + std::to_string( i ), true ) );
+    }
+
+    auto rssStart = getRss();
+
+    for( auto &id : sessions ) {
+        id = util::SessionId::generate();
+        store.add( id );
+
+        for( auto key : keys ) {
+            store.addKey( id, key, VALUE, sizeof( VALUE ) - 1, counterKeys, counterRecord );
+        }
+    }
+
+    auto rssEnd = getRss();
+    std::mt19937 rng( 1 );
+    std::vector<unsigned int> queries( COUNT_QUERIES );
+    util::PayloadRef value;
+    unsigned long int countFound = 0;
+
+    for( auto &query : queries ) {
+        query = rng();
+    }
+
+    auto tStart = std::chrono::steady_clock::now();
+
+    for( auto query : queries ) {
+        auto &id = sessions[query % COUNT_SESSIONS];
+        auto key = keys[( query >> 20 ) % countKeys];
+
+        if( store.getKey( id, key, value, counterKeys, counterRecord ) == Store::Result::OK ) {
+            countFound++;
+        }
+    }
+
+    auto tEnd = std::chrono::steady_clock::now();
+
+    printf(
+        "keys %-3u bytes/session %.1f getKey %.1f ns found %lu/%u\n",
+        countKeys,
+        double( rssEnd - rssStart ) / COUNT_SESSIONS,
+        std::chrono::duration<double, std::nano>( tEnd - tStart ).count() / COUNT_QUERIES,
+        countFound,
+        COUNT_QUERIES
+    );
+}
@@ -4,6 +4,7 @@
 #include "src/core/cmd.hpp"
 #include "src/core/monitoring.hpp"
 #include "src/util/console.hpp"
+#include "src/util/policy.hpp"
 #include <string>
 #include <iostream>
 #include <memory>
@@ -11,41 +12,119 @@
 
 using namespace memsess::util;
 
-void startServer( memsess::core::ServerController *controller, memsess::core::Monitoring *monitoring, unsigned short int port ) {
-    memsess::core::Server server( port, controller, monitoring );
+template<typename Controller, typename Monitoring>
+void startServer( Controller *controller, Monitoring *monitoring, unsigned short int port ) {
+    memsess::core::Server<Controller, Monitoring> server( port, controller, monitoring );
     server.run();
 }
 
-void start( unsigned int limit, unsigned short int port, unsigned short int threads ) {
-    std::cout << "limit " << limit << std::endl;
-    std::cout << "threads " << threads << std::endl;
-    std::cout << "port " << port << std::endl;
+const char *evictions[] = { "lru", "lfu", "ttl" };
+
+template<typename Policy>
+void run(
+    unsigned int limit,
+    unsigned short int port,
+    unsigned short int threads,
+    unsigned int shards,
+    unsigned long int memory,
+    memsess::i::StoreInterface::Eviction eviction,
+    unsigned int compression,
+    unsigned int deduplication,
+    unsigned long int capacity,
+    const std::string &log,
+    unsigned int logThreshold,
+    unsigned long int logIdle,
+    unsigned int limitKeys
+) {
+    typedef memsess::core::Monitoring<Policy> Monitoring;
+    typedef memsess::core::Store<Policy, Monitoring> Store;
+    typedef memsess::core::ServerController<Store, Monitoring> Controller;
 
+    Epoch::setShared( Policy::IS_MULTI );
 
-    memsess::core::Monitoring monitoring;
-    memsess::core::Store store( &monitoring );
+    Monitoring monitoring;
+    Store store( &monitoring, shards );
     store.setLimit( limit );
+    store.setLimitKeys( limitKeys );
+    store.setMemory( memory, eviction );
+    store.setCompression( compression );
+    store.setDeduplication( deduplication );
+    store.reserve( capacity );
+    store.setMaintenance( threads );
 
-    memsess::core::ServerController controller( &store, &monitoring );
+    if( !log.empty() && !store.setLog( log, logThreshold, logIdle ) ) {
+        memsess::util::Console::printDanger( "The value log could not be opened" );
+        return;
+    }
+
+    Controller controller( &store, &monitoring );
 
-    memsess::core::Server server( port, &controller, &monitoring, true );
+    memsess::core::Server<Controller, Monitoring> server( port, &controller, &monitoring, true );
     memsess::util::Console::printSuccess( "Start server" );
 
-    if( threads > 1 ) {
-        for( unsigned int i = 1; i < threads; i++ ) {
-            std::thread t( startServer, &controller, &monitoring, port );
-            t.detach();
-        }
+    for( unsigned int i = 1; i < threads; i++ ) {
+        std::thread t( startServer<Controller, Monitoring>, &controller, &monitoring, port );
+        t.detach();
     }
 
     server.run();
 }
 
+void start(
+    unsigned int limit,
+    unsigned short int port,
+    unsigned short int threads,
+    unsigned int shards,
+    unsigned long int memory,
+    memsess::i::StoreInterface::Eviction eviction,
+    unsigned int compression,
+    unsigned int deduplication,
+    unsigned long int capacity,
+    const std::string &log,
+    unsigned int logThreshold,
+    unsigned long int logIdle,
+    unsigned int limitKeys
+) {
+    std::cout << "limit " << limit << std::endl;
+    std::cout << "limit keys " << limitKeys << std::endl;
+    std::cout << "memory " << memory << std::endl;
+    std::cout << "eviction " << evictions[eviction] << std::endl;
+    std::cout << "compression " << compression << std::endl;
+    std::cout << "deduplication " << deduplication << std::endl;
+    std::cout << "capacity " << capacity << std::endl;
+    std::cout << "log " << log << std::endl;
+    std::cout << "log threshold " << logThreshold << std::endl;
+    std::cout << "log idle " << logIdle << std::endl;
+    std::cout << "threads " << threads << std::endl;
+    std::cout << "shards " << shards << std::endl;
+    std::cout << "port " << port << std::endl;
+
+    if( threads > 1 ) {
+        run<PolicyMulti>( limit, port, threads, shards, memory, eviction, compression, deduplication, capacity, log, logThreshold, logIdle, limitKeys );
+    } else {
+        run<PolicyMono>( limit, port, threads, shards, memory, eviction, compression, deduplication, capacity, log, logThreshold, logIdle, limitKeys );
+    }
+}
+
 int main( int argc, char* argv[] ) {
 
     try {
         memsess::core::Cmd cmd( argc, argv );
-        start( cmd.getLimit(), cmd.getPort(), cmd.getThreads() );
+        start(
+            cmd.getLimit(),
+            cmd.getPort(),
+            cmd.getThreads(),
+            cmd.getShards(),
+            cmd.getMemory(),
+            cmd.getEviction(),
+            cmd.getCompression(),
+            cmd.getDeduplication(),
+            cmd.getCapacity(),
+            cmd.getLog(),
+            cmd.getLogThreshold(),
+            cmd.getLogIdle(),
+            cmd.getLimitKeys()
+        );
     } catch( memsess::core::Cmd::Err err ) {
         switch( err ) {
             case memsess::core::Cmd::E_WRONG_PORT:
@@ -57,10 +136,40 @@ int main( int argc, char* argv[] ) {
             case memsess::core::Cmd::E_WRONG_THREADS:
                 memsess::util::Console::printDanger( "Wrong threads" );
                 break;
+            case memsess::core::Cmd::E_WRONG_SHARDS:
+                memsess::util::Console::printDanger( "Wrong shards" );
+                break;
+            case memsess::core::Cmd::E_WRONG_MEMORY:
+                memsess::util::Console::printDanger( "Wrong memory" );
+                break;
+            case memsess::core::Cmd::E_WRONG_EVICTION:
+                memsess::util::Console::printDanger( "Wrong eviction" );
+                break;
+            case memsess::core::Cmd::E_WRONG_COMPRESSION:
+                memsess::util::Console::printDanger( "Wrong compression" );
+                break;
+            case memsess::core::Cmd::E_WRONG_DEDUPLICATION:
+                memsess::util::Console::printDanger( "Wrong deduplication" );
+                break;
+            case memsess::core::Cmd::E_WRONG_CAPACITY:
+                memsess::util::Console::printDanger( "Wrong capacity" );
+                break;
+            case memsess::core::Cmd::E_WRONG_LOG:
+                memsess::util::Console::printDanger( "Wrong log" );
+                break;
+            case memsess::core::Cmd::E_WRONG_LOG_THRESHOLD:
+                memsess::util::Console::printDanger( "Wrong log threshold" );
+                break;
+            case memsess::core::Cmd::E_WRONG_LOG_IDLE:
+                memsess::util::Console::printDanger( "Wrong log idle" );
+                break;
+            case memsess::core::Cmd::E_WRONG_LIMIT_KEYS:
+                memsess::util::Console::printDanger( "Wrong limit keys" );
+                break;
         }
-    } catch( memsess::core::Server::Err err ) {
+    } catch( memsess::core::ServerBase::Err err ) {
         switch( err ) {
-            case memsess::core::Server::E_SERVER_ERROR:
+            case memsess::core::ServerBase::E_SERVER_ERROR:
                 memsess::util::Console::printDanger( "The server could not be started" );
                 break;
         }
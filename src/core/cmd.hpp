@@ -4,6 +4,8 @@
 #include <string>
 #include <stdlib.h>
 #include <thread>
+#include <sys/stat.h>
+#include "../interfaces/store_interface.h"
 
 namespace memsess::core {
     class Cmd {
@@ -12,36 +14,83 @@ namespace memsess::core {
                 E_WRONG_PORT,
                 E_WRONG_LIMIT,
                 E_WRONG_THREADS,
+                E_WRONG_SHARDS,
+                E_WRONG_MEMORY,
+                E_WRONG_EVICTION,
+                E_WRONG_COMPRESSION,
+                E_WRONG_DEDUPLICATION,
+                E_WRONG_CAPACITY,
+                E_WRONG_LOG,
+                E_WRONG_LOG_THRESHOLD,
+                E_WRONG_LOG_IDLE,
+                E_WRONG_LIMIT_KEYS,
             };
         private:
             enum CMD {
                 CMD_LIMIT,
                 CMD_PORT,
                 CMD_THREADS,
+                CMD_SHARDS,
+                CMD_MEMORY,
+                CMD_EVICTION,
+                CMD_COMPRESSION,
+                CMD_DEDUPLICATION,
+                CMD_CAPACITY,
+                CMD_LOG,
+                CMD_LOG_THRESHOLD,
+                CMD_LOG_IDLE,
+                CMD_LIMIT_KEYS,
                 CMD_UNKNOWN,
             };
 
+            const unsigned int COUNT_SHARDS_MULTI = 64;
             const unsigned int _defaultThreads = std::thread::hardware_concurrency();
 
             unsigned int _limit = 0xFFFFFFFF;
-#if MEMSESS_MULTI
             unsigned short int _threads = _defaultThreads;
-#else
-            unsigned short int _threads = 1;
-#endif
+            unsigned int _shards = 0;
             unsigned short int _port = 2901;
+            unsigned long int _memory = 0;
+            i::StoreInterface::Eviction _eviction = i::StoreInterface::EVICTION_LRU;
+            unsigned int _compression = 0;
+            unsigned int _deduplication = 0;
+            unsigned long int _capacity = 0;
+            std::string _log;
+            unsigned int _logThreshold = 4'096;
+            unsigned long int _logIdle = 0;
+            unsigned int _limitKeys = 1'048'576;
 
             CMD _getCommand( const char *value );
 
             unsigned int _getLimit( const char *value );
             unsigned short int _getPort( const char *value );
             unsigned short int _getThreads( const char *value );
+            unsigned int _getShards( const char *value );
+            unsigned long int _getMemory( const char *value );
+            i::StoreInterface::Eviction _getEviction( const char *value );
+            unsigned int _getCompression( const char *value );
+            unsigned int _getDeduplication( const char *value );
+            unsigned long int _getCapacity( const char *value );
+            std::string _getLog( const char *value );
+            unsigned int _getLogThreshold( const char *value );
+            unsigned long int _getLogIdle( const char *value );
+            unsigned int _getLimitKeys( const char *value );
 
         public:
             Cmd( int argc, char* argv[] );
             unsigned int getLimit();
             unsigned int getThreads();
             unsigned int getPort();
+            unsigned int getShards();
+            unsigned long int getMemory();
+            i::StoreInterface::Eviction getEviction();
+            unsigned int getCompression();
+            unsigned int getDeduplication();
+            unsigned long int getCapacity();
+            const std::string &getLog();
+            unsigned int getLogThreshold();
+            unsigned long int getLogIdle();
+            unsigned int getLimitKeys();
     };
 
     Cmd::Cmd( int argc, char* argv[] ) {
@@ -59,11 +108,39 @@ namespace memsess::core {
                     case CMD_PORT:
                         _port = _getPort( value );
                         break;
-#if MEMSESS_MULTI
                     case CMD_THREADS:
                         _threads = _getThreads( value );
                         break;
-#endif
+                    case CMD_SHARDS:
+                        _shards = _getShards( value );
+                        break;
+                    case CMD_MEMORY:
+                        _memory = _getMemory( value );
+                        break;
+                    case CMD_EVICTION:
+                        _eviction = _getEviction( value );
+                        break;
+                    case CMD_COMPRESSION:
+                        _compression = _getCompression( value );
+                        break;
+                    case CMD_DEDUPLICATION:
+                        _deduplication = _getDeduplication( value );
+                        break;
+                    case CMD_CAPACITY:
+                        _capacity = _getCapacity( value );
+                        break;
+                    case CMD_LOG:
+                        _log = _getLog( value );
+                        break;
+                    case CMD_LOG_THRESHOLD:
+                        _logThreshold = _getLogThreshold( value );
+                        break;
+                    case CMD_LOG_IDLE:
+                        _logIdle = _getLogIdle( value );
+                        break;
+                    case CMD_LIMIT_KEYS:
+                        _limitKeys = _getLimitKeys( value );
+                        break;
                 }
 
                 cmd = CMD_UNKNOWN;
@@ -80,6 +157,26 @@ namespace memsess::core {
             return CMD_PORT;
         } else if( str == "-t" ) {
             return CMD_THREADS;
+        } else if( str == "-s" ) {
+            return CMD_SHARDS;
+        } else if( str == "-m" ) {
+            return CMD_MEMORY;
+        } else if( str == "-e" ) {
+            return CMD_EVICTION;
+        } else if( str == "-c" ) {
+            return CMD_COMPRESSION;
+        } else if( str == "-d" ) {
+            return CMD_DEDUPLICATION;
+        } else if( str == "-r" ) {
+            return CMD_CAPACITY;
+        } else if( str == "-v" ) {
+            return CMD_LOG;
+        } else if( str == "-b" ) {
+            return CMD_LOG_THRESHOLD;
+        } else if( str == "-i" ) {
+            return CMD_LOG_IDLE;
+        } else if( str == "-k" ) {
+            return CMD_LIMIT_KEYS;
         }
 
         return CMD_UNKNOWN;
@@ -115,6 +212,123 @@ namespace memsess::core {
         return v;
     }
 
+    unsigned int Cmd::_getShards( const char *value ) {
+        auto v = atoi( value );
+
+        if( v <= 0 || v > 0xFFFF ) {
+            throw E_WRONG_SHARDS;
+        }
+
+        return v;
+    }
+
+    unsigned long int Cmd::_getMemory( const char *value ) {
+        char *end;
+        auto v = strtoul( value, &end, 10 );
+
+        if( *end == 'K' || *end == 'k' ) {
+            v <<= 10;
+            end++;
+        } else if( *end == 'M' || *end == 'm' ) {
+            v <<= 20;
+            end++;
+        } else if( *end == 'G' || *end == 'g' ) {
+            v <<= 30;
+            end++;
+        }
+
+        if( v == 0 || end == value || *end != 0 ) {
+            throw E_WRONG_MEMORY;
+        }
+
+        return v;
+    }
+
+    i::StoreInterface::Eviction Cmd::_getEviction( const char *value ) {
+        auto str = std::string( value );
+
+        if( str == "lru" ) {
+            return i::StoreInterface::EVICTION_LRU;
+        } else if( str == "lfu" ) {
+            return i::StoreInterface::EVICTION_LFU;
+        } else if( str == "ttl" ) {
+            return i::StoreInterface::EVICTION_TTL;
+        }
+
+        throw E_WRONG_EVICTION;
+    }
+
+    unsigned int Cmd::_getCompression( const char *value ) {
+        auto v = atoi( value );
+
+        if( v <= 0 ) {
+            throw E_WRONG_COMPRESSION;
+        }
+
+        return v;
+    }
+
+    unsigned int Cmd::_getDeduplication( const char *value ) {
+        auto v = atoi( value );
+
+        if( v <= 0 ) {
+            throw E_WRONG_DEDUPLICATION;
+        }
+
+        return v;
+    }
+
+    unsigned long int Cmd::_getCapacity( const char *value ) {
+        char *end;
+        auto v = strtoul( value, &end, 10 );
+
+        if( v == 0 || end == value || *end != 0 ) {
+            throw E_WRONG_CAPACITY;
+        }
+
+        return v;
+    }
+
+    std::string Cmd::_getLog( const char *value ) {
+        struct stat st;
+
+        if( stat( value, &st ) != 0 || !S_ISDIR( st.st_mode ) ) {
+            throw E_WRONG_LOG;
+        }
+
+        return value;
+    }
+
+    unsigned int Cmd::_getLogThreshold( const char *value ) {
+        auto v = atoi( value );
+
+        if( v <= 0 ) {
+            throw E_WRONG_LOG_THRESHOLD;
+        }
+
+        return v;
+    }
+
+    unsigned long int Cmd::_getLogIdle( const char *value ) {
+        auto v = atoi( value );
+
+        if( v <= 0 ) {
+            throw E_WRONG_LOG_IDLE;
+        }
+
+        return v * 1'000UL;
+    }
+
+    unsigned int Cmd::_getLimitKeys( const char *value ) {
+        auto v = atoi( value );
+
+        if( v <= 0 ) {
+            throw E_WRONG_LIMIT_KEYS;
+        }
+
+        return v;
+    }
+
     unsigned int Cmd::getLimit() {
         return _limit;
     }
@@ -126,6 +340,54 @@ namespace memsess::core {
     unsigned int Cmd::getThreads() {
         return _threads;
     }
+
+    unsigned int Cmd::getShards() {
+        if( _shards == 0 ) {
+            return _threads > 1 ? COUNT_SHARDS_MULTI : 1;
+        }
+
+        return _shards;
+    }
+
+    unsigned long int Cmd::getMemory() {
+        return _memory;
+    }
+
+    i::StoreInterface::Eviction Cmd::getEviction() {
+        return _eviction;
+    }
+
+    unsigned int Cmd::getCompression() {
+        return _compression;
+    }
+
+    unsigned int Cmd::getDeduplication() {
+        return _deduplication;
+    }
+
+    unsigned long int Cmd::getCapacity() {
+        if( _capacity == 0 && _limit != 0xFFFFFFFF ) {
+            return _limit;
+        }
+
+        return _capacity;
+    }
+
+    const std::string &Cmd::getLog() {
+        return _log;
+    }
+
+    unsigned int Cmd::getLogThreshold() {
+        return _logThreshold;
+    }
+
+    unsigned long int Cmd::getLogIdle() {
+        return _logIdle;
+    }
+
+    unsigned int Cmd::getLimitKeys() {
+        return _limitKeys;
+    }
 }
 
 #endif
@@ -2,87 +2,116 @@
 #define MEMSESS_CORE_MONITORING
 
 #include "../interfaces/monitoring_interface.h"
-#include <atomic>
+#include <memory>
+#include <mutex>
 
 namespace memsess::core {
-    class Monitoring: public i::MonitoringInterface {
+    template<typename Policy>
+    class Monitoring final: public i::MonitoringInterface {
         private:
-            std::atomic<unsigned long int> _sendedBytes{ 0 };
-            std::atomic<unsigned long int> _receivedBytes{ 0 };
-
-            std::atomic<unsigned long int> _passedGenerate{ 0 };
-            std::atomic<unsigned long int> _passedExist{ 0 };
-            std::atomic<unsigned long int> _passedAdd{ 0 };
-            std::atomic<unsigned long int> _passedProlong{ 0 };
-            std::atomic<unsigned long int> _passedRemove{ 0 };
-            std::atomic<unsigned long int> _passedAddKey{ 0 };
-            std::atomic<unsigned long int> _passedExistKey{ 0 };
-            std::atomic<unsigned long int> _passedRemoveKey{ 0 };
-            std::atomic<unsigned long int> _passedProlongKey{ 0 };
-            std::atomic<unsigned long int> _passedGetKey{ 0 };
-            std::atomic<unsigned long int> _passedSetKey{ 0 };
-            std::atomic<unsigned long int> _passedSetForceKey{ 0 };
-            std::atomic<unsigned long int> _passedAddKeyToAll{ 0 };
-            std::atomic<unsigned long int> _passedRemoveKeyFromAll{ 0 };
-
-            std::atomic<unsigned long int> _failedGenerate{ 0 };
-            std::atomic<unsigned long int> _failedExist{ 0 };
-            std::atomic<unsigned long int> _failedAdd{ 0 };
-            std::atomic<unsigned long int> _failedProlong{ 0 };
-            std::atomic<unsigned long int> _failedRemove{ 0 };
-            std::atomic<unsigned long int> _failedAddKey{ 0 };
-            std::atomic<unsigned long int> _failedExistKey{ 0 };
-            std::atomic<unsigned long int> _failedRemoveKey{ 0 };
-            std::atomic<unsigned long int> _failedProlongKey{ 0 };
-            std::atomic<unsigned long int> _failedGetKey{ 0 };
-            std::atomic<unsigned long int> _failedSetKey{ 0 };
-            std::atomic<unsigned long int> _failedSetForceKey{ 0 };
-            std::atomic<unsigned long int> _failedAddKeyToAll{ 0 };
-            std::atomic<unsigned long int> _failedRemoveKeyFromAll{ 0 };
-
-            std::atomic<unsigned long int> _errorWrongCommand{ 0 };
-            std::atomic<unsigned long int> _errorWrongParams{ 0 };
-            std::atomic<unsigned long int> _errorSessionNone{ 0 };
-            std::atomic<unsigned long int> _errorKeyNone{ 0 };
-            std::atomic<unsigned long int> _errorLimitExceeded{ 0 };
-            std::atomic<unsigned long int> _errorLifetimeExceeded{ 0 };
-            std::atomic<unsigned long int> _errorDuplicateKey{ 0 };
-            std::atomic<unsigned long int> _errorRecordBeenChanged{ 0 };
-            std::atomic<unsigned long int> _errorLimitPerSecExceeded{ 0 };
-            std::atomic<unsigned long int> _errorDuplicateSession{ 0 };
-            std::atomic<unsigned long int> _errorDisconnection{ 0 };
-
-            std::atomic<unsigned long int> _durationReceivingLess5ms{ 0 };
-            std::atomic<unsigned long int> _durationReceivingLess10ms{ 0 };
-            std::atomic<unsigned long int> _durationReceivingLess20ms{ 0 };
-            std::atomic<unsigned long int> _durationReceivingLess50ms{ 0 };
-            std::atomic<unsigned long int> _durationReceivingLess100ms{ 0 };
-            std::atomic<unsigned long int> _durationReceivingLess200ms{ 0 };
-            std::atomic<unsigned long int> _durationReceivingLess500ms{ 0 };
-            std::atomic<unsigned long int> _durationReceivingLess1000ms{ 0 };
-            std::atomic<unsigned long int> _durationReceivingOther{ 0 };
-
-            std::atomic<unsigned long int> _durationSendingLess5ms{ 0 };
-            std::atomic<unsigned long int> _durationSendingLess10ms{ 0 };
-            std::atomic<unsigned long int> _durationSendingLess20ms{ 0 };
-            std::atomic<unsigned long int> _durationSendingLess50ms{ 0 };
-            std::atomic<unsigned long int> _durationSendingLess100ms{ 0 };
-            std::atomic<unsigned long int> _durationSendingLess200ms{ 0 };
-            std::atomic<unsigned long int> _durationSendingLess500ms{ 0 };
-            std::atomic<unsigned long int> _durationSendingLess1000ms{ 0 };
-            std::atomic<unsigned long int> _durationSendingOther{ 0 };
-
-            std::atomic<unsigned long int> _durationProcessingLess5ms{ 0 };
-            std::atomic<unsigned long int> _durationProcessingLess10ms{ 0 };
-            std::atomic<unsigned long int> _durationProcessingLess20ms{ 0 };
-            std::atomic<unsigned long int> _durationProcessingLess50ms{ 0 };
-            std::atomic<unsigned long int> _durationProcessingLess100ms{ 0 };
-            std::atomic<unsigned long int> _durationProcessingLess200ms{ 0 };
-            std::atomic<unsigned long int> _durationProcessingLess500ms{ 0 };
-            std::atomic<unsigned long int> _durationProcessingLess1000ms{ 0 };
-            std::atomic<unsigned long int> _durationProcessingOther{ 0 };
-
-            std::atomic<unsigned int> _totalFreeSessions{ 0 };
+            template<typename T>
+            using Atomic = typename Policy::template Atomic<T>;
+
+            Atomic<unsigned long int> _sendedBytes{ 0 };
+            Atomic<unsigned long int> _receivedBytes{ 0 };
+
+            Atomic<unsigned long int> _passedGenerate{ 0 };
+            Atomic<unsigned long int> _passedExist{ 0 };
+            Atomic<unsigned long int> _passedAdd{ 0 };
+            Atomic<unsigned long int> _passedProlong{ 0 };
+            Atomic<unsigned long int> _passedRemove{ 0 };
+            Atomic<unsigned long int> _passedAddKey{ 0 };
+            Atomic<unsigned long int> _passedExistKey{ 0 };
+            Atomic<unsigned long int> _passedRemoveKey{ 0 };
+            Atomic<unsigned long int> _passedProlongKey{ 0 };
+            Atomic<unsigned long int> _passedGetKey{ 0 };
+            Atomic<unsigned long int> _passedSetKey{ 0 };
+            Atomic<unsigned long int> _passedSetForceKey{ 0 };
+            Atomic<unsigned long int> _passedAddKeyToAll{ 0 };
+            Atomic<unsigned long int> _passedRemoveKeyFromAll{ 0 };
+
+            Atomic<unsigned long int> _failedGenerate{ 0 };
+            Atomic<unsigned long int> _failedExist{ 0 };
+            Atomic<unsigned long int> _failedAdd{ 0 };
+            Atomic<unsigned long int> _failedProlong{ 0 };
+            Atomic<unsigned long int> _failedRemove{ 0 };
+            Atomic<unsigned long int> _failedAddKey{ 0 };
+            Atomic<unsigned long int> _failedExistKey{ 0 };
+            Atomic<unsigned long int> _failedRemoveKey{ 0 };
+            Atomic<unsigned long int> _failedProlongKey{ 0 };
+            Atomic<unsigned long int> _failedGetKey{ 0 };
+            Atomic<unsigned long int> _failedSetKey{ 0 };
+            Atomic<unsigned long int> _failedSetForceKey{ 0 };
+            Atomic<unsigned long int> _failedAddKeyToAll{ 0 };
+            Atomic<unsigned long int> _failedRemoveKeyFromAll{ 0 };
+
+            Atomic<unsigned long int> _errorWrongCommand{ 0 };
+            Atomic<unsigned long int> _errorWrongParams{ 0 };
+            Atomic<unsigned long int> _errorSessionNone{ 0 };
+            Atomic<unsigned long int> _errorKeyNone{ 0 };
+            Atomic<unsigned long int> _errorLimitExceeded{ 0 };
+            Atomic<unsigned long int> _errorLifetimeExceeded{ 0 };
+            Atomic<unsigned long int> _errorDuplicateKey{ 0 };
+            Atomic<unsigned long int> _errorRecordBeenChanged{ 0 };
+            Atomic<unsigned long int> _errorLimitPerSecExceeded{ 0 };
+            Atomic<unsigned long int> _errorDuplicateSession{ 0 };
+            Atomic<unsigned long int> _errorDisconnection{ 0 };
+
+            Atomic<unsigned long int> _durationReceivingLess5ms{ 0 };
+            Atomic<unsigned long int> _durationReceivingLess10ms{ 0 };
+            Atomic<unsigned long int> _durationReceivingLess20ms{ 0 };
+            Atomic<unsigned long int> _durationReceivingLess50ms{ 0 };
+            Atomic<unsigned long int> _durationReceivingLess100ms{ 0 };
+            Atomic<unsigned long int> _durationReceivingLess200ms{ 0 };
+            Atomic<unsigned long int> _durationReceivingLess500ms{ 0 };
+            Atomic<unsigned long int> _durationReceivingLess1000ms{ 0 };
+            Atomic<unsigned long int> _durationReceivingOther{ 0 };
+
+            Atomic<unsigned long int> _durationSendingLess5ms{ 0 };
+            Atomic<unsigned long int> _durationSendingLess10ms{ 0 };
+            Atomic<unsigned long int> _durationSendingLess20ms{ 0 };
+            Atomic<unsigned long int> _durationSendingLess50ms{ 0 };
+            Atomic<unsigned long int> _durationSendingLess100ms{ 0 };
+            Atomic<unsigned long int> _durationSendingLess200ms{ 0 };
+            Atomic<unsigned long int> _durationSendingLess500ms{ 0 };
+            Atomic<unsigned long int> _durationSendingLess1000ms{ 0 };
+            Atomic<unsigned long int> _durationSendingOther{ 0 };
+
+            Atomic<unsigned long int> _durationProcessingLess5ms{ 0 };
+            Atomic<unsigned long int> _durationProcessingLess10ms{ 0 };
+            Atomic<unsigned long int> _durationProcessingLess20ms{ 0 };
+            Atomic<unsigned long int> _durationProcessingLess50ms{ 0 };
+            Atomic<unsigned long int> _durationProcessingLess100ms{ 0 };
+            Atomic<unsigned long int> _durationProcessingLess200ms{ 0 };
+            Atomic<unsigned long int> _durationProcessingLess500ms{ 0 };
+            Atomic<unsigned long int> _durationProcessingLess1000ms{ 0 };
+            Atomic<unsigned long int> _durationProcessingOther{ 0 };
+
+            Atomic<unsigned int> _totalFreeSessions{ 0 };
+
+            unsigned int _countShards = 0;
+            std::unique_ptr<Atomic<unsigned int>[]> _shardSessions;
+
+            std::vector<DataSlab> _slabs;
+            typename Policy::Mutex _mSlabs;
+
+            Atomic<unsigned long int> _memoryLimit{ 0 };
+            Atomic<unsigned long int> _memoryBytes{ 0 };
+            Atomic<unsigned long int> _evictions{ 0 };
+            Atomic<unsigned long int> _bytesEvicted{ 0 };
+            Atomic<unsigned long int> _bytesStored{ 0 };
+            Atomic<unsigned long int> _bytesLogical{ 0 };
+            Atomic<unsigned long int> _bytesLocks{ 0 };
+            Atomic<unsigned long int> _bytesPooled{ 0 };
+            Atomic<unsigned long int> _bytesShared{ 0 };
+            Atomic<unsigned long int> _bytesReclaimed{ 0 };
+            Atomic<unsigned long int> _allocations{ 0 };
+            Atomic<unsigned long int> _bytesLog{ 0 };
+            Atomic<unsigned long int> _bytesLogLive{ 0 };
+            Atomic<unsigned long int> _maintenanceJobs{ 0 };
+            Atomic<unsigned long int> _maintenanceDuration{ 0 };
+            Atomic<unsigned long int> _maintenanceDurationMax{ 0 };
+            Atomic<unsigned long int> _maintenanceQueue{ 0 };
 
         public:
             void incSendedBytes( unsigned int );
@@ -135,176 +164,232 @@ namespace memsess::core {
             void updateDurationSending( unsigned int );
 
             void updateTotalFreeSessions( unsigned int );
+            void setCountShards( unsigned int );
+            void updateShardSessions( unsigned int, unsigned int );
+            void updateSlabs( const std::vector<DataSlab> & );
+            void setMemoryLimit( unsigned long int );
+            void updateMemory( unsigned long int );
+            void incEvictions( unsigned long int );
+            void updateValueBytes( unsigned long int, unsigned long int );
+            void setLockBytes( unsigned long int );
+            void updatePoolBytes( unsigned long int, unsigned long int );
+            void incReclaimed( unsigned long int );
+            void incAllocations( unsigned long int );
+            void updateLogBytes( unsigned long int, unsigned long int );
+            void updateDurationMaintenance( unsigned long int );
+            void updateQueueMaintenance( unsigned int );
 
             void getData( Data &data );
     };
 
-    void Monitoring::incSendedBytes( unsigned int bytes ) {
+    template<typename Policy>
+    void Monitoring<Policy>::incSendedBytes( unsigned int bytes ) {
         _sendedBytes += bytes;
     }
 
-    void Monitoring::incReceivedBytes( unsigned int bytes ) {
+    template<typename Policy>
+    void Monitoring<Policy>::incReceivedBytes( unsigned int bytes ) {
         _receivedBytes += bytes;
     }
 
-    void Monitoring::incPassedGenerate() {
+    template<typename Policy>
+    void Monitoring<Policy>::incPassedGenerate() {
         _passedGenerate++;
     }
 
-    void Monitoring::incPassedExist() {
+    template<typename Policy>
+    void Monitoring<Policy>::incPassedExist() {
         _passedExist++;
     }
 
-    void Monitoring::incPassedAdd() {
+    template<typename Policy>
+    void Monitoring<Policy>::incPassedAdd() {
         _passedAdd++;
     }
 
-    void Monitoring::incPassedProlong() {
+    template<typename Policy>
+    void Monitoring<Policy>::incPassedProlong() {
         _passedProlong++;
     }
 
-    void Monitoring::incPassedRemove() {
+    template<typename Policy>
+    void Monitoring<Policy>::incPassedRemove() {
         _passedRemove++;
     }
 
-    void Monitoring::incPassedAddKey() {
+    template<typename Policy>
+    void Monitoring<Policy>::incPassedAddKey() {
         _passedAddKey++;
     }
 
-    void Monitoring::incPassedExistKey() {
+    template<typename Policy>
+    void Monitoring<Policy>::incPassedExistKey() {
         _passedExistKey++;
     }
 
-    void Monitoring::incPassedRemoveKey() {
+    template<typename Policy>
+    void Monitoring<Policy>::incPassedRemoveKey() {
         _passedRemoveKey++;
     }
 
-    void Monitoring::incPassedProlongKey() {
+    template<typename Policy>
+    void Monitoring<Policy>::incPassedProlongKey() {
         _passedProlongKey++;
     }
 
-    void Monitoring::incPassedGetKey() {
+    template<typename Policy>
+    void Monitoring<Policy>::incPassedGetKey() {
         _passedGetKey++;
     }
 
-    void Monitoring::incPassedSetKey() {
+    template<typename Policy>
+    void Monitoring<Policy>::incPassedSetKey() {
         _passedSetKey++;
     }
 
-    void Monitoring::incPassedSetForceKey() {
+    template<typename Policy>
+    void Monitoring<Policy>::incPassedSetForceKey() {
         _passedSetForceKey++;
     }
 
-    void Monitoring::incPassedAddKeyToAll() {
+    template<typename Policy>
+    void Monitoring<Policy>::incPassedAddKeyToAll() {
         _passedAddKeyToAll++;
     }
 
-    void Monitoring::incPassedRemoveKeyFromAll() {
+    template<typename Policy>
+    void Monitoring<Policy>::incPassedRemoveKeyFromAll() {
         _passedRemoveKeyFromAll++;
     }
 
 
-    void Monitoring::incFailedGenerate() {
+    template<typename Policy>
+    void Monitoring<Policy>::incFailedGenerate() {
         _failedGenerate++;
     }
 
-    void Monitoring::incFailedExist() {
+    template<typename Policy>
+    void Monitoring<Policy>::incFailedExist() {
         _failedExist++;
     }
 
-    void Monitoring::incFailedAdd() {
+    template<typename Policy>
+    void Monitoring<Policy>::incFailedAdd() {
         _failedAdd++;
     }
 
-    void Monitoring::incFailedProlong() {
+    template<typename Policy>
+    void Monitoring<Policy>::incFailedProlong() {
         _failedProlong++;
     }
 
-    void Monitoring::incFailedRemove() {
+    template<typename Policy>
+    void Monitoring<Policy>::incFailedRemove() {
         _failedRemove++;
     }
 
-    void Monitoring::incFailedAddKey() {
+    template<typename Policy>
+    void Monitoring<Policy>::incFailedAddKey() {
         _failedAddKey++;
     }
 
-    void Monitoring::incFailedExistKey() {
+    template<typename Policy>
+    void Monitoring<Policy>::incFailedExistKey() {
         _failedExistKey++;
     }
 
-    void Monitoring::incFailedRemoveKey() {
+    template<typename Policy>
+    void Monitoring<Policy>::incFailedRemoveKey() {
         _failedRemoveKey++;
     }
 
-    void Monitoring::incFailedProlongKey() {
+    template<typename Policy>
+    void Monitoring<Policy>::incFailedProlongKey() {
         _failedProlongKey++;
     }
 
-    void Monitoring::incFailedGetKey() {
+    template<typename Policy>
+    void Monitoring<Policy>::incFailedGetKey() {
         _failedGetKey++;
     }
 
-    void Monitoring::incFailedSetKey() {
+    template<typename Policy>
+    void Monitoring<Policy>::incFailedSetKey() {
         _failedSetKey++;
     }
 
-    void Monitoring::incFailedSetForceKey() {
+    template<typename Policy>
+    void Monitoring<Policy>::incFailedSetForceKey() {
         _failedSetForceKey++;
     }
 
-    void Monitoring::incFailedAddKeyToAll() {
+    template<typename Policy>
+    void Monitoring<Policy>::incFailedAddKeyToAll() {
         _failedAddKeyToAll++;
     }
 
-    void Monitoring::incFailedRemoveKeyFromAll() {
+    template<typename Policy>
+    void Monitoring<Policy>::incFailedRemoveKeyFromAll() {
         _failedRemoveKeyFromAll++;
     }
 
-    void Monitoring::incErrorWrongCommand() {
+    template<typename Policy>
+    void Monitoring<Policy>::incErrorWrongCommand() {
         _errorWrongCommand++;
     }
 
-    void Monitoring::incErrorWrongParams() {
+    template<typename Policy>
+    void Monitoring<Policy>::incErrorWrongParams() {
         _errorWrongParams++;
     }
 
-    void Monitoring::incErrorSessionNone() {
+    template<typename Policy>
+    void Monitoring<Policy>::incErrorSessionNone() {
         _errorSessionNone++;
     }
 
-    void Monitoring::incErrorKeyNone() {
+    template<typename Policy>
+    void Monitoring<Policy>::incErrorKeyNone() {
         _errorKeyNone++;
     }
 
-    void Monitoring::incErrorLimitExceeded() {
+    template<typename Policy>
+    void Monitoring<Policy>::incErrorLimitExceeded() {
         _errorLimitExceeded++;
     }
 
-    void Monitoring::incErrorLifetimeExceeded() {
+    template<typename Policy>
+    void Monitoring<Policy>::incErrorLifetimeExceeded() {
         _errorLifetimeExceeded++;
     }
 
-    void Monitoring::incErrorDuplicateKey() {
+    template<typename Policy>
+    void Monitoring<Policy>::incErrorDuplicateKey() {
         _errorDuplicateKey++;
     }
 
-    void Monitoring::incErrorRecordBeenChanged() {
+    template<typename Policy>
+    void Monitoring<Policy>::incErrorRecordBeenChanged() {
         _errorRecordBeenChanged++;
     }
 
-    void Monitoring::incErrorLimitPerSecExceeded() {
+    template<typename Policy>
+    void Monitoring<Policy>::incErrorLimitPerSecExceeded() {
         _errorLimitPerSecExceeded++;
     }
 
-    void Monitoring::incErrorDuplicateSession() {
+    template<typename Policy>
+    void Monitoring<Policy>::incErrorDuplicateSession() {
         _errorDuplicateSession++;
     }
 
-    void Monitoring::incErrorDisconnection() {
+    template<typename Policy>
+    void Monitoring<Policy>::incErrorDisconnection() {
         _errorDisconnection++;
     }
 
-    void Monitoring::updateDurationReceiving( unsigned int ms ) {
+    template<typename Policy>
+    void Monitoring<Policy>::updateDurationReceiving( unsigned int ms ) {
         if( ms < 5 ) {
             _durationReceivingLess5ms++;
         } else if( ms < 10 ) {
@@ -326,7 +411,8 @@ namespace memsess::core {
         }
     }
 
-    void Monitoring::updateDurationProcessing( unsigned int ms ) {
+    template<typename Policy>
+    void Monitoring<Policy>::updateDurationProcessing( unsigned int ms ) {
         if( ms < 5 ) {
             _durationProcessingLess5ms++;
         } else if( ms < 10 ) {
@@ -348,7 +434,8 @@ namespace memsess::core {
         }
     }
 
-    void Monitoring::updateDurationSending( unsigned int ms ) {
+    template<typename Policy>
+    void Monitoring<Policy>::updateDurationSending( unsigned int ms ) {
         if( ms < 5 ) {
             _durationSendingLess5ms++;
         } else if( ms < 10 ) {
@@ -370,11 +457,96 @@ namespace memsess::core {
         }
     }
 
-    void Monitoring::updateTotalFreeSessions( unsigned int total ) {
+    template<typename Policy>
+    void Monitoring<Policy>::updateTotalFreeSessions( unsigned int total ) {
         _totalFreeSessions = total;
     }
 
-    void Monitoring::getData( Data &data ) {
+    template<typename Policy>
+    void Monitoring<Policy>::setCountShards( unsigned int count ) {
+        _countShards = count;
+        _shardSessions = std::make_unique<Atomic<unsigned int>[]>( count );
+    }
+
+    template<typename Policy>
+    void Monitoring<Policy>::updateShardSessions( unsigned int shard, unsigned int total ) {
+        if( shard < _countShards ) {
+            _shardSessions[shard] = total;
+        }
+    }
+
+    template<typename Policy>
+    void Monitoring<Policy>::updateSlabs( const std::vector<DataSlab> &slabs ) {
+        std::lock_guard<typename Policy::Mutex> lock( _mSlabs );
+        _slabs = slabs;
+    }
+
+    template<typename Policy>
+    void Monitoring<Policy>::setMemoryLimit( unsigned long int limit ) {
+        _memoryLimit = limit;
+    }
+
+    template<typename Policy>
+    void Monitoring<Policy>::updateMemory( unsigned long int bytes ) {
+        _memoryBytes = bytes;
+    }
+
+    template<typename Policy>
+    void Monitoring<Policy>::incEvictions( unsigned long int bytes ) {
+        _evictions++;
+        _bytesEvicted += bytes;
+    }
+
+    template<typename Policy>
+    void Monitoring<Policy>::updateValueBytes( unsigned long int stored, unsigned long int logical ) {
+        _bytesStored = stored;
+        _bytesLogical = logical;
+    }
+
+    template<typename Policy>
+    void Monitoring<Policy>::setLockBytes( unsigned long int bytes ) {
+        _bytesLocks = bytes;
+    }
+
+    template<typename Policy>
+    void Monitoring<Policy>::updatePoolBytes( unsigned long int pooled, unsigned long int shared ) {
+        _bytesPooled = pooled;
+        _bytesShared = shared;
+    }
+
+    template<typename Policy>
+    void Monitoring<Policy>::incReclaimed( unsigned long int bytes ) {
+        _bytesReclaimed += bytes;
+    }
+
+    template<typename Policy>
+    void Monitoring<Policy>::incAllocations( unsigned long int count ) {
+        _allocations += count;
+    }
+
+    template<typename Policy>
+    void Monitoring<Policy>::updateLogBytes( unsigned long int mapped, unsigned long int live ) {
+        _bytesLog = mapped;
+        _bytesLogLive = live;
+    }
+
+    template<typename Policy>
+    void Monitoring<Policy>::updateDurationMaintenance( unsigned long int ms ) {
+        _maintenanceJobs++;
+        _maintenanceDuration = ms;
+
+        if( ms > _maintenanceDurationMax ) {
+            _maintenanceDurationMax = ms;
+        }
+    }
+
+    template<typename Policy>
+    void Monitoring<Policy>::updateQueueMaintenance( unsigned int depth ) {
+        _maintenanceQueue = depth;
+    }
+
+    template<typename Policy>
+    void Monitoring<Policy>::getData( Data &data ) {
         data.traffic.sendedBytes = _sendedBytes;
         data.traffic.receivedBytes = _receivedBytes;
 
@@ -451,6 +623,33 @@ namespace memsess::core {
         data.durationSending.other = _durationSendingOther;
 
         data.totalFreeSessions = _totalFreeSessions;
+
+        data.shardSessions.resize( _countShards );
+        for( unsigned int i = 0; i < _countShards; i++ ) {
+            data.shardSessions[i] = _shardSessions[i];
+        }
+
+        data.memory.limit = _memoryLimit;
+        data.memory.bytes = _memoryBytes;
+        data.memory.evictions = _evictions;
+        data.memory.bytesEvicted = _bytesEvicted;
+        data.memory.bytesStored = _bytesStored;
+        data.memory.bytesLogical = _bytesLogical;
+        data.memory.bytesLocks = _bytesLocks;
+        data.memory.bytesPooled = _bytesPooled;
+        data.memory.bytesShared = _bytesShared;
+        data.memory.bytesReclaimed = _bytesReclaimed;
+        data.memory.allocations = _allocations;
+        data.memory.bytesLog = _bytesLog;
+        data.memory.bytesLogLive = _bytesLogLive;
+
+        data.maintenance.jobs = _maintenanceJobs;
+        data.maintenance.duration = _maintenanceDuration;
+        data.maintenance.durationMax = _maintenanceDurationMax;
+        data.maintenance.queue = _maintenanceQueue;
+
+        std::lock_guard<typename Policy::Mutex> lock( _mSlabs );
+        data.slabs = _slabs;
     }
 }
 
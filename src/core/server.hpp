@@ -3,6 +3,7 @@
 
 #include <event2/event.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <arpa/inet.h>
@@ -12,22 +13,29 @@
 #include <random>
 #include <memory>
 #include <unistd.h>
-#include "../interfaces/server_controller_interface.h"
-#include "../interfaces/monitoring_interface.h"
 #include "../util/time.hpp"
+#include "../util/clock.hpp"
+#include "../util/payload.hpp"
+#include "../util/byte_buffer.hpp"
+#include "../util/allocations.hpp"
 
 namespace memsess::core {
-
-    class Server {
+    class ServerBase {
         public:
             enum Err {
                 E_SERVER_ERROR,
             };
+    };
+
+    template<typename Controller, typename Monitoring>
+    class Server: public ServerBase {
         private:
             struct Buffer {
                 unsigned int length;
                 unsigned int wrLength;
-                std::unique_ptr<char[]> data;
+                util::ByteBuffer data;
+                util::PayloadRef payload;
+                unsigned int payloadOffset;
             };
             struct Connection {
                 struct event* readEvent;
@@ -36,8 +44,8 @@ namespace memsess::core {
                 Buffer readBuf;
                 Buffer writeBuf;
             };
-            static inline i::ServerControllerInterface *_controller = nullptr;
-            static inline i::MonitoringInterface *_monitoring = nullptr;
+            static inline Controller *_controller = nullptr;
+            static inline Monitoring *_monitoring = nullptr;
 
             unsigned int _createSocket();
             void _bindSocket( unsigned int fd );
@@ -53,13 +61,16 @@ namespace memsess::core {
             static void close( int sock, Connection *conn );
             static void timer( int sock, short what, void *arg );
             static void clearBuffer( Buffer &buffer );
+            static ssize_t sendBuffer( int sock, Buffer &buffer );
+            static unsigned int getLengthBuffer( Buffer &buffer );
 
         public:
-            Server( unsigned short int port, i::ServerControllerInterface *controller, i::MonitoringInterface *monitoring, bool isTimer = false );
+            Server( unsigned short int port, Controller *controller, Monitoring *monitoring, bool isTimer = false );
             void run();
     };
 
-    unsigned int Server::_createSocket() {
+    template<typename Controller, typename Monitoring>
+    unsigned int Server<Controller, Monitoring>::_createSocket() {
         auto sock = socket( AF_INET, SOCK_STREAM, 0 );
 
         if( sock == -1 ) {
@@ -78,7 +89,8 @@ namespace memsess::core {
         return sock;
     }
 
-    void Server::_bindSocket( unsigned int fd ) {
+    template<typename Controller, typename Monitoring>
+    void Server<Controller, Monitoring>::_bindSocket( unsigned int fd ) {
         struct sockaddr_in addr;
         addr.sin_family = AF_INET;
         addr.sin_port = htons( _port );
@@ -89,7 +101,8 @@ namespace memsess::core {
         }
     }
 
-    Server::Server( unsigned short int port, i::ServerControllerInterface *controller, i::MonitoringInterface *monitoring, bool isTimer ) {
+    template<typename Controller, typename Monitoring>
+    Server<Controller, Monitoring>::Server( unsigned short int port, Controller *controller, Monitoring *monitoring, bool isTimer ) {
         _port = port;
         _isTimer = isTimer;
         _controller = controller;
@@ -98,7 +111,8 @@ namespace memsess::core {
         _bindSocket( _sfd );
     }
 
-    void Server::close( int sock, Connection *conn ) {
+    template<typename Controller, typename Monitoring>
+    void Server<Controller, Monitoring>::close( int sock, Connection *conn ) {
         event_del( conn->readEvent );
         event_free( conn->readEvent );
         event_del( conn->writeEvent );
@@ -112,7 +126,8 @@ namespace memsess::core {
         ::close( sock );
     }
 
-    void Server::read( int sock, short what, void *arg ) {
+    template<typename Controller, typename Monitoring>
+    void Server<Controller, Monitoring>::read( int sock, short what, void *arg ) {
         Connection *conn = (Connection *)arg;
 
         if( conn->readBuf.length == 0 ) {
@@ -137,10 +152,10 @@ namespace memsess::core {
 
             conn->readBuf.length = lengthData;
             conn->readBuf.wrLength = 0;
-            conn->readBuf.data = std::make_unique<char[]>( lengthData );
+            conn->readBuf.data.reserve( lengthData );
         }
 
-        auto l = ::recv( sock, &conn->readBuf.data.get()[conn->readBuf.wrLength], conn->readBuf.length - conn->readBuf.wrLength, MSG_NOSIGNAL );
+        auto l = ::recv( sock, &conn->readBuf.data.getData()[conn->readBuf.wrLength], conn->readBuf.length - conn->readBuf.wrLength, MSG_NOSIGNAL );
 
         if( l <= 0 ) {
             close( sock, conn );
@@ -153,9 +168,20 @@ namespace memsess::core {
 
         if( conn->readBuf.wrLength == conn->readBuf.length ) {
             _monitoring->updateDurationReceiving( util::Time::getMs() - conn->tMonitoring );
+#if MEMSESS_COUNT_ALLOCATIONS
+            auto countAllocations = util::Allocations::getCount();
+#endif
             unsigned int resultLength = 0;
             auto tStart = util::Time::getMs();
-            auto result = _controller->parse( conn->readBuf.data.get(), conn->readBuf.length, resultLength );
+            util::Clock::update();
+            _controller->parse(
+                conn->readBuf.data.getData(),
+                conn->readBuf.length,
+                conn->writeBuf.data,
+                resultLength,
+                conn->writeBuf.payload,
+                conn->writeBuf.payloadOffset
+            );
 
             _monitoring->updateDurationProcessing( util::Time::getMs() - tStart );
             clearBuffer( conn->readBuf );
@@ -163,11 +189,10 @@ namespace memsess::core {
             if( resultLength == 0 ) {
                 close( sock, conn );
             } else {
-                conn->writeBuf.data = std::move( result );
                 conn->writeBuf.length = resultLength;
                 conn->tMonitoring = util::Time::getMs();
 
-                auto l = ::send( sock, &conn->writeBuf.data[conn->writeBuf.wrLength], conn->writeBuf.length - conn->writeBuf.wrLength, MSG_NOSIGNAL );
+                auto l = sendBuffer( sock, conn->writeBuf );
 
                 if( l <= 0 ) {
                     close( sock, conn );
@@ -179,22 +204,26 @@ namespace memsess::core {
 
                 conn->writeBuf.wrLength += l;
 
-                if( conn->writeBuf.wrLength == conn->writeBuf.length ) {
+                if( conn->writeBuf.wrLength == getLengthBuffer( conn->writeBuf ) ) {
                     _monitoring->updateDurationSending( util::Time::getMs() - conn->tMonitoring );
                     clearBuffer( conn->writeBuf );
                 }
             }
+#if MEMSESS_COUNT_ALLOCATIONS
+            _monitoring->incAllocations( util::Allocations::getCount() - countAllocations );
+#endif
         }
     }
 
-    void Server::write( int sock, short what, void *arg ) {
+    template<typename Controller, typename Monitoring>
+    void Server<Controller, Monitoring>::write( int sock, short what, void *arg ) {
         Connection *conn = (Connection *)arg;
 
-        if( conn->writeBuf.data.get() == nullptr ) {
+        if( conn->writeBuf.length == 0 ) {
             return;
         }
 
-        auto l = ::send( sock, &conn->writeBuf.data[conn->writeBuf.wrLength], conn->writeBuf.length - conn->writeBuf.wrLength, MSG_NOSIGNAL );
+        auto l = sendBuffer( sock, conn->writeBuf );
 
         if( l <= 0 ) {
             close( sock, conn );
@@ -206,28 +235,75 @@ namespace memsess::core {
 
         conn->writeBuf.wrLength += l;
 
-        if( conn->writeBuf.wrLength == conn->writeBuf.length ) {
+        if( conn->writeBuf.wrLength == getLengthBuffer( conn->writeBuf ) ) {
             _monitoring->updateDurationSending( util::Time::getMs() - conn->tMonitoring );
             clearBuffer( conn->writeBuf );
         }
     }
 
-    void Server::clearBuffer( Buffer &buffer ) {
+    template<typename Controller, typename Monitoring>
+    void Server<Controller, Monitoring>::clearBuffer( Buffer &buffer ) {
         buffer.wrLength = 0;
         buffer.length = 0;
 
-        buffer.data.reset();
+        buffer.data.shrink();
+        buffer.payload.reset();
+        buffer.payloadOffset = 0;
+    }
+
+    template<typename Controller, typename Monitoring>
+    unsigned int Server<Controller, Monitoring>::getLengthBuffer( Buffer &buffer ) {
+        return buffer.length + buffer.payload.getLength();
+    }
+
+    template<typename Controller, typename Monitoring>
+    ssize_t Server<Controller, Monitoring>::sendBuffer( int sock, Buffer &buffer ) {
+        struct iovec iov[3];
+        unsigned int count = 0;
+        auto lengthPayload = buffer.payload.getLength();
+        auto endPayload = buffer.payloadOffset + lengthPayload;
+        auto total = getLengthBuffer( buffer );
+        auto offset = buffer.wrLength;
+
+        if( offset < buffer.payloadOffset ) {
+            iov[count].iov_base = &buffer.data.getData()[offset];
+            iov[count].iov_len = buffer.payloadOffset - offset;
+            count++;
+            offset = buffer.payloadOffset;
+        }
+
+        if( offset < endPayload ) {
+            iov[count].iov_base = ( void * )&buffer.payload.getData()[offset - buffer.payloadOffset];
+            iov[count].iov_len = endPayload - offset;
+            count++;
+            offset = endPayload;
+        }
+
+        if( offset < total ) {
+            iov[count].iov_base = &buffer.data.getData()[offset - lengthPayload];
+            iov[count].iov_len = total - offset;
+            count++;
+        }
+
+        struct msghdr msg = {};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+
+        return ::sendmsg( sock, &msg, MSG_NOSIGNAL );
     }
 
-    void Server::timer( int sock, short what, void *arg ) {
+    template<typename Controller, typename Monitoring>
+    void Server<Controller, Monitoring>::timer( int sock, short what, void *arg ) {
         auto tStart = util::Time::getMs();
+        util::Clock::update();
         _controller->interval();
         auto tEnd = util::Time::getMs();
 
         _monitoring->updateDurationProcessing( tEnd - tStart );
     }
 
-    void Server::accept( int sock, short what, void *arg) {
+    template<typename Controller, typename Monitoring>
+    void Server<Controller, Monitoring>::accept( int sock, short what, void *arg) {
         auto fd = ::accept( sock, 0, 0 );
 
         if( fd < 0 ) {
@@ -250,7 +326,8 @@ namespace memsess::core {
         event_add( conn->writeEvent, NULL );
     }
 
-    void Server::run() {
+    template<typename Controller, typename Monitoring>
+    void Server<Controller, Monitoring>::run() {
         if( listen( _sfd, COUNT_LISTEN ) == -1 ) {
             throw E_SERVER_ERROR;
         }
@@ -266,7 +343,7 @@ namespace memsess::core {
 
         if( _isTimer ) {
             struct timeval time;
-            time.tv_sec = 60;
+            time.tv_sec = 1;
             time.tv_usec = 0;
 
             auto ev = event_new( ( base ), -1, EV_PERSIST, Server::timer, NULL );
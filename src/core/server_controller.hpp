@@ -4,21 +4,32 @@
 #include <arpa/inet.h>
 #include <string.h>
 #include <string>
+#include <string_view>
+#include <iterator>
+#include <vector>
 #include "../interfaces/server_controller_interface.h"
 #include "../interfaces/store_interface.h"
 #include "../interfaces/monitoring_interface.h"
 #include "../util/uuid.hpp"
+#include "../util/session_id.hpp"
 #include "../util/serialization.hpp"
+#include "../util/payload.hpp"
+#include "../util/byte_buffer.hpp"
 
 
 namespace memsess::core {
     using namespace util;
     using namespace i;
 
-    class ServerController: public i::ServerControllerInterface {
+    template<typename Store, typename Monitoring>
+    class ServerController final: public i::ServerControllerInterface {
         private:
-            i::StoreInterface *_store;
-            i::MonitoringInterface *_monitoring;
+            Store *_store;
+            Monitoring *_monitoring;
+            static const unsigned char FLAG_MS = 0x80;
+            static const unsigned long int MS_PER_SEC = 1'000;
+            static const unsigned short int MAX_SCAN_COUNT = 1'000;
+            static const unsigned char FLAG_SCAN_KEYS = 0x01;
             enum Commands {
                 GENERATE = 1,
                 EXIST = 2,
@@ -35,6 +46,12 @@ namespace memsess::core {
                 ALL_REMOVE_KEY = 15,
                 ADD_SESSION = 18,
                 GET_STATISTICS = 19,
+                GET_COMPRESSED_KEY = 20,
+                SET_TAG = 21,
+                TAG_REMOVE = 22,
+                TAG_PROLONG = 23,
+                TAG_LIST = 24,
+                SCAN = 25,
             };
             enum ResultCode {
                 OK = 1,
@@ -51,7 +68,8 @@ namespace memsess::core {
             };
             struct Params {
                 const char *uuidRaw;
-                const char *key;
+                StoreInterface::KeyId key;
+                std::string_view tag;
                 const char *data;
                 unsigned int dataLength;
                 unsigned int lifetime;
@@ -59,30 +77,48 @@ namespace memsess::core {
                 unsigned int counterRecord;
                 unsigned short int limitWrite;
                 unsigned short int limitRead;
+                unsigned long int cursor;
+                unsigned short int count;
+                bool isKeys;
             };
 
             bool initParams( const char *data, unsigned int length, Params &params );
             bool initCmd( char cmd );
             ResultCode convertStoreError( StoreInterface::Result error );
             bool isNoUUIDCmd( char cmd );
+            bool isLifetimeCmd( char cmd );
             void updateMonitoringErrors( ResultCode code );
             void updateMonitoringRequests( unsigned char cmd, ResultCode code );
+            void packResult( Serialization::Item **items, util::ByteBuffer &result, unsigned int &resultLength );
+            void packResult(
+                Serialization::Item **itemsHead,
+                Serialization::Item **itemsTail,
+                unsigned int lengthPayload,
+                util::ByteBuffer &result,
+                unsigned int &resultLength,
+                unsigned int &payloadOffset
+            );
         public:
-            ServerController( i::StoreInterface *store, i::MonitoringInterface *monitoring );
-            std::unique_ptr<char[]> parse(
+            ServerController( Store *store, Monitoring *monitoring );
+            void parse(
                 const char *data,
                 unsigned int length,
-                unsigned int &resultLength
+                util::ByteBuffer &result,
+                unsigned int &resultLength,
+                util::PayloadRef &payload,
+                unsigned int &payloadOffset
             );
             void interval();
     };
 
-    ServerController::ServerController( i::StoreInterface *store, i::MonitoringInterface *monitoring ) {
+    template<typename Store, typename Monitoring>
+    ServerController<Store, Monitoring>::ServerController( Store *store, Monitoring *monitoring ) {
         _store = store;
         _monitoring = monitoring;
     }
 
-    bool ServerController::initCmd( char cmd ) {
+    template<typename Store, typename Monitoring>
+    bool ServerController<Store, Monitoring>::initCmd( char cmd ) {
         switch( cmd ) {
             case GENERATE:
             case EXIST:
@@ -99,13 +135,20 @@ namespace memsess::core {
             case ALL_REMOVE_KEY:
             case ADD_SESSION:
             case GET_STATISTICS:
+            case GET_COMPRESSED_KEY:
+            case SET_TAG:
+            case TAG_REMOVE:
+            case TAG_PROLONG:
+            case TAG_LIST:
+            case SCAN:
                 return true;
             default:
                 return false;
         }
     }
 
-    void ServerController::updateMonitoringRequests( unsigned char cmd, ResultCode code ) {
+    template<typename Store, typename Monitoring>
+    void ServerController<Store, Monitoring>::updateMonitoringRequests( unsigned char cmd, ResultCode code ) {
         if( code == ResultCode::OK ) {
             switch( cmd ) {
                 case Commands::GENERATE:
@@ -127,6 +170,7 @@ namespace memsess::core {
                     _monitoring->incPassedAddKeyToAll();
                     break;
                 case Commands::GET_KEY:
+                case Commands::GET_COMPRESSED_KEY:
                     _monitoring->incPassedGetKey();
                     break;
                 case Commands::REMOVE_KEY:
@@ -176,6 +220,7 @@ namespace memsess::core {
                     _monitoring->incFailedAddKeyToAll();
                     break;
                 case Commands::GET_KEY:
+                case Commands::GET_COMPRESSED_KEY:
                     _monitoring->incFailedGetKey();
                     break;
                 case Commands::REMOVE_KEY:
@@ -209,7 +254,8 @@ namespace memsess::core {
         }
     }
 
-    void ServerController::updateMonitoringErrors( ResultCode code ) {
+    template<typename Store, typename Monitoring>
+    void ServerController<Store, Monitoring>::updateMonitoringErrors( ResultCode code ) {
         switch( code ) {
             case ResultCode::WRONG_COMMAND:
                 _monitoring->incErrorWrongCommand();
@@ -241,15 +287,22 @@ namespace memsess::core {
             case ResultCode::DUPLICATE_SESSION:
                 _monitoring->incErrorDuplicateSession();
                 break;
+            case ResultCode::OK:
+                break;
         }
     }
 
-    bool ServerController::isNoUUIDCmd( char cmd ) {
+    template<typename Store, typename Monitoring>
+    bool ServerController<Store, Monitoring>::isNoUUIDCmd( char cmd ) {
         switch( cmd ) {
             case Commands::GENERATE:
             case Commands::GET_STATISTICS:
             case Commands::ALL_ADD_KEY:
             case Commands::ALL_REMOVE_KEY:
+            case Commands::TAG_REMOVE:
+            case Commands::TAG_PROLONG:
+            case Commands::TAG_LIST:
+            case Commands::SCAN:
                 return true;
             default:
                 return false;
@@ -257,7 +310,23 @@ namespace memsess::core {
         }
     }
 
-    ServerController::ResultCode ServerController::convertStoreError( StoreInterface::Result error ) {
+    template<typename Store, typename Monitoring>
+    bool ServerController<Store, Monitoring>::isLifetimeCmd( char cmd ) {
+        switch( cmd ) {
+            case Commands::GENERATE:
+            case Commands::PROLONG:
+            case Commands::ADD_KEY:
+            case Commands::PROLONG_KEY:
+            case Commands::ADD_SESSION:
+            case Commands::TAG_PROLONG:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    template<typename Store, typename Monitoring>
+    typename ServerController<Store, Monitoring>::ResultCode ServerController<Store, Monitoring>::convertStoreError( StoreInterface::Result error ) {
         switch( error ) {
             case StoreInterface::E_SESSION_NONE:
                 return SESSION_NONE;
@@ -280,7 +349,8 @@ namespace memsess::core {
         }
     }
 
-    bool ServerController::initParams( const char *data, unsigned int length, Params &params ) {
+    template<typename Store, typename Monitoring>
+    bool ServerController<Store, Monitoring>::initParams( const char *data, unsigned int length, Params &params ) {
 
         Serialization::Item uuid;
         uuid.type = Serialization::FIXED_STRING;
@@ -307,6 +377,15 @@ namespace memsess::core {
         Serialization::Item limitRead;
         limitRead.type = Serialization::SHORT_INT;
 
+        Serialization::Item cursor;
+        cursor.type = Serialization::LONG_INT;
+
+        Serialization::Item count;
+        count.type = Serialization::SHORT_INT;
+
+        Serialization::Item flags;
+        flags.type = Serialization::CHAR;
+
         Serialization::Item end;
         end.type = Serialization::END;
 
@@ -323,8 +402,12 @@ namespace memsess::core {
         Serialization::Item *listAllRemoveKey[] = { &key, &end };
         Serialization::Item *listAddSession[] = { &uuid, &lifetime, &end };
         Serialization::Item *listGetStatistics[] = { &end };
+        Serialization::Item *listSetTag[] = { &uuid, &key, &end };
+        Serialization::Item *listTag[] = { &key, &end };
+        Serialization::Item *listTagProlong[] = { &key, &lifetime, &end };
+        Serialization::Item *listScan[] = { &cursor, &count, &flags, &end };
 
-        switch( data[0] ) {
+        switch( ( unsigned char )data[0] & ~FLAG_MS ) {
             case Commands::GENERATE:
                 if( !Serialization::unpack( listGenerate, &data[1], length - 1 ) ) {
                     return false;
@@ -353,7 +436,7 @@ namespace memsess::core {
                 }
 
 
-                params.key = key.value_string;
+                params.key = _store->getKeyId( std::string_view( key.value_string, key.length ), true );
                 params.data = value.value_string;
                 params.dataLength = value.length;
                 params.uuidRaw = uuid.value_string;
@@ -365,7 +448,7 @@ namespace memsess::core {
                 }
 
 
-                params.key = key.value_string;
+                params.key = _store->getKeyId( std::string_view( key.value_string, key.length ), true );
                 params.data = value.value_string;
                 params.dataLength = value.length;
                 break;
@@ -375,15 +458,16 @@ namespace memsess::core {
                 }
 
 
-                params.key = key.value_string;
+                params.key = _store->getKeyId( std::string_view( key.value_string, key.length ) );
                 break;
             case Commands::GET_KEY:
+            case Commands::GET_COMPRESSED_KEY:
                 if( !Serialization::unpack( listGetKey, &data[1], length - 1 ) ) {
                     return false;
                 }
 
                 params.uuidRaw = uuid.value_string;
-                params.key = key.value_string;
+                params.key = _store->getKeyId( std::string_view( key.value_string, key.length ) );
                 params.limitRead = ( unsigned short int )limitRead.value_short_int;
 
                 break;
@@ -395,7 +479,7 @@ namespace memsess::core {
 
 
                 params.uuidRaw = uuid.value_string;
-                params.key = key.value_string;
+                params.key = _store->getKeyId( std::string_view( key.value_string, key.length ) );
                 break;
             case Commands::SET_KEY:
                 if( !Serialization::unpack( listSetKey, &data[1], length - 1 ) ) {
@@ -403,7 +487,7 @@ namespace memsess::core {
                 }
 
                 params.uuidRaw = uuid.value_string;
-                params.key = key.value_string;
+                params.key = _store->getKeyId( std::string_view( key.value_string, key.length ) );
                 params.data = value.value_string;
                 params.dataLength = value.length;
                 params.counterKeys = counterKeys.value_int;
@@ -416,7 +500,7 @@ namespace memsess::core {
                 }
 
                 params.uuidRaw = uuid.value_string;
-                params.key = key.value_string;
+                params.key = _store->getKeyId( std::string_view( key.value_string, key.length ) );
                 params.data = value.value_string;
                 params.dataLength = value.length;
                 params.limitWrite = ( unsigned short int )limitWrite.value_short_int;
@@ -427,7 +511,7 @@ namespace memsess::core {
                 }
 
                 params.uuidRaw = uuid.value_string;
-                params.key = key.value_string;
+                params.key = _store->getKeyId( std::string_view( key.value_string, key.length ) );
                 params.lifetime = lifetime.value_int;
                 break;
             case Commands::ADD_SESSION:
@@ -443,6 +527,43 @@ namespace memsess::core {
                     return false;
                 }
                 break;
+            case Commands::SET_TAG:
+                if( !Serialization::unpack( listSetTag, &data[1], length - 1 ) ) {
+                    return false;
+                }
+
+                params.uuidRaw = uuid.value_string;
+                params.tag = std::string_view( key.value_string, key.length );
+                break;
+            case Commands::TAG_REMOVE:
+            case Commands::TAG_LIST:
+                if( !Serialization::unpack( listTag, &data[1], length - 1 ) ) {
+                    return false;
+                }
+
+                params.tag = std::string_view( key.value_string, key.length );
+                break;
+            case Commands::TAG_PROLONG:
+                if( !Serialization::unpack( listTagProlong, &data[1], length - 1 ) ) {
+                    return false;
+                }
+
+                params.tag = std::string_view( key.value_string, key.length );
+                params.lifetime = lifetime.value_int;
+                break;
+            case Commands::SCAN:
+                if( !Serialization::unpack( listScan, &data[1], length - 1 ) ) {
+                    return false;
+                }
+
+                params.cursor = ( unsigned long int )cursor.value_long_int;
+                params.count = ( unsigned short int )count.value_short_int;
+                params.isKeys = ( flags.value_char & FLAG_SCAN_KEYS ) != 0;
+
+                if( params.count == 0 || params.count > MAX_SCAN_COUNT ) {
+                    params.count = MAX_SCAN_COUNT;
+                }
+                break;
             default:
                 return false;
         }
@@ -450,21 +571,70 @@ namespace memsess::core {
         return true;
     }
 
-    std::unique_ptr<char[]> ServerController::parse(
+    template<typename Store, typename Monitoring>
+    void ServerController<Store, Monitoring>::packResult(
+        Serialization::Item **items,
+        util::ByteBuffer &result,
+        unsigned int &resultLength
+    ) {
+        auto length = Serialization::getLength( ( const Serialization::Item ** )items );
+        auto data = result.reserve( sizeof( int ) + length );
+        unsigned int lengthNet = htonl( length );
+
+        memcpy( data, &lengthNet, sizeof( int ) );
+        Serialization::pack( ( const Serialization::Item ** )items, &data[sizeof( int )] );
+        resultLength = sizeof( int ) + length;
+    }
+
+    template<typename Store, typename Monitoring>
+    void ServerController<Store, Monitoring>::packResult(
+        Serialization::Item **itemsHead,
+        Serialization::Item **itemsTail,
+        unsigned int lengthPayload,
+        util::ByteBuffer &result,
+        unsigned int &resultLength,
+        unsigned int &payloadOffset
+    ) {
+        auto lengthHead = Serialization::getLength( ( const Serialization::Item ** )itemsHead );
+        auto lengthTail = Serialization::getLength( ( const Serialization::Item ** )itemsTail );
+        auto data = result.reserve( sizeof( int ) + lengthHead + lengthTail );
+        unsigned int lengthNet = htonl( lengthHead + lengthPayload + lengthTail );
+
+        memcpy( data, &lengthNet, sizeof( int ) );
+        Serialization::pack( ( const Serialization::Item ** )itemsHead, &data[sizeof( int )] );
+        Serialization::pack( ( const Serialization::Item ** )itemsTail, &data[sizeof( int ) + lengthHead] );
+        resultLength = sizeof( int ) + lengthHead + lengthTail;
+        payloadOffset = sizeof( int ) + lengthHead;
+    }
+
+    template<typename Store, typename Monitoring>
+    void ServerController<Store, Monitoring>::parse(
         const char *data,
         unsigned int length,
-        unsigned int &resultLength
+        util::ByteBuffer &result,
+        unsigned int &resultLength,
+        util::PayloadRef &payload,
+        unsigned int &payloadOffset
     ) {
-        Params params;
+        Params params{};
         resultLength = 0;
+        payloadOffset = 0;
 
-        unsigned char cmd = data[0];
+        unsigned char cmd = ( unsigned char )data[0] & ~FLAG_MS;
+        bool isMs = ( data[0] & FLAG_MS ) != 0;
+        unsigned long int lifetime;
 
-        char uuid[UUID::LENGTH+1] = {};
+        SessionId sessionId;
         char uuidRaw[UUID::LENGTH_RAW] = {};
-        std::string value;
+        util::PayloadRef value;
         unsigned int counterKeys;
         unsigned int counterRecord;
+        unsigned int count = 0;
+        std::vector<SessionId> sessions;
+        std::string sessionsRaw;
+        unsigned long int cursor = 0;
+        std::vector<StoreInterface::ScanItem> scanItems;
+        std::vector<Serialization::Item> itemsScan;
 
         i::MonitoringInterface::Data monitoringData;
 
@@ -477,11 +647,8 @@ namespace memsess::core {
         itemUUID.type = Serialization::FIXED_STRING;
         itemUUID.length = UUID::LENGTH_RAW;
 
-        Serialization::Item itemValue;
-        itemValue.type = Serialization::STRING;
-
-        Serialization::Item itemValueFinal;
-        itemValueFinal.type = Serialization::STRING;
+        Serialization::Item itemValueLength;
+        itemValueLength.type = Serialization::INT;
 
         Serialization::Item itemCounterKeys;
         itemCounterKeys.type = Serialization::INT;
@@ -489,6 +656,18 @@ namespace memsess::core {
         Serialization::Item itemCounterRecord;
         itemCounterRecord.type = Serialization::INT;
 
+        Serialization::Item itemValueLengthOriginal;
+        itemValueLengthOriginal.type = Serialization::INT;
+
+        Serialization::Item itemCount;
+        itemCount.type = Serialization::INT;
+
+        Serialization::Item itemSessions;
+        itemSessions.type = Serialization::FIXED_STRING;
+
+        Serialization::Item itemCursor;
+        itemCursor.type = Serialization::LONG_INT;
+
 
 
 
@@ -724,6 +903,67 @@ namespace memsess::core {
         Serialization::Item itemMonitoringTotalFreeSessions;
         itemMonitoringTotalFreeSessions.type = Serialization::LONG_INT;
 
+        Serialization::Item itemMonitoringCountShards;
+        itemMonitoringCountShards.type = Serialization::INT;
+
+        std::vector<Serialization::Item> itemsMonitoringShardSessions;
+
+        Serialization::Item itemMonitoringCountSlabs;
+        itemMonitoringCountSlabs.type = Serialization::INT;
+
+        std::vector<Serialization::Item> itemsMonitoringSlabs;
+
+        Serialization::Item itemMonitoringMemoryLimit;
+        itemMonitoringMemoryLimit.type = Serialization::LONG_INT;
+
+        Serialization::Item itemMonitoringMemoryBytes;
+        itemMonitoringMemoryBytes.type = Serialization::LONG_INT;
+
+        Serialization::Item itemMonitoringEvictions;
+        itemMonitoringEvictions.type = Serialization::LONG_INT;
+
+        Serialization::Item itemMonitoringBytesEvicted;
+        itemMonitoringBytesEvicted.type = Serialization::LONG_INT;
+
+        Serialization::Item itemMonitoringBytesStored;
+        itemMonitoringBytesStored.type = Serialization::LONG_INT;
+
+        Serialization::Item itemMonitoringBytesLogical;
+        itemMonitoringBytesLogical.type = Serialization::LONG_INT;
+
+        Serialization::Item itemMonitoringBytesLocks;
+        itemMonitoringBytesLocks.type = Serialization::LONG_INT;
+
+        Serialization::Item itemMonitoringBytesPooled;
+        itemMonitoringBytesPooled.type = Serialization::LONG_INT;
+
+        Serialization::Item itemMonitoringBytesShared;
+        itemMonitoringBytesShared.type = Serialization::LONG_INT;
+
+        Serialization::Item itemMonitoringBytesReclaimed;
+        itemMonitoringBytesReclaimed.type = Serialization::LONG_INT;
+
+        Serialization::Item itemMonitoringAllocations;
+        itemMonitoringAllocations.type = Serialization::LONG_INT;
+
+        Serialization::Item itemMonitoringBytesLog;
+        itemMonitoringBytesLog.type = Serialization::LONG_INT;
+
+        Serialization::Item itemMonitoringBytesLogLive;
+        itemMonitoringBytesLogLive.type = Serialization::LONG_INT;
+
+        Serialization::Item itemMonitoringMaintenanceJobs;
+        itemMonitoringMaintenanceJobs.type = Serialization::LONG_INT;
+
+        Serialization::Item itemMonitoringMaintenanceDuration;
+        itemMonitoringMaintenanceDuration.type = Serialization::LONG_INT;
+
+        Serialization::Item itemMonitoringMaintenanceDurationMax;
+        itemMonitoringMaintenanceDurationMax.type = Serialization::LONG_INT;
+
+        Serialization::Item itemMonitoringMaintenanceQueue;
+        itemMonitoringMaintenanceQueue.type = Serialization::LONG_INT;
+
 
         Serialization::Item itemEnd;
         itemEnd.type = Serialization::END;
@@ -731,8 +971,19 @@ namespace memsess::core {
         Serialization::Item *listNone[] = { &itemResult, &itemEnd };
         Serialization::Item *listGenerate[] = { &itemResult, &itemUUID, &itemEnd };
         Serialization::Item *listAddKey[] = { &itemResult, &itemCounterKeys, &itemCounterRecord, &itemEnd };
-        Serialization::Item *listGetKey[] = { &itemResult, &itemValue, &itemCounterKeys, &itemCounterRecord, &itemEnd };
-        Serialization::Item *listGetStatics[] = {
+        Serialization::Item *listGetKeyHead[] = { &itemResult, &itemValueLength, &itemEnd };
+        Serialization::Item *listTagCount[] = { &itemResult, &itemCount, &itemEnd };
+        Serialization::Item *listTagList[] = { &itemResult, &itemCount, &itemSessions, &itemEnd };
+        std::vector<Serialization::Item *> listScan;
+        Serialization::Item *listGetKeyTail[] = { &itemCounterKeys, &itemCounterRecord, &itemEnd };
+        Serialization::Item *listGetCompressedKeyTail[] = {
+            &itemCounterKeys,
+            &itemCounterRecord,
+            &itemValueLengthOriginal,
+            &itemEnd
+        };
+        std::vector<Serialization::Item *> listGetStatics;
+        Serialization::Item *listGetStaticsHead[] = {
             &itemResult,
 
             &itemMonitoringSendedBytes,
@@ -812,58 +1063,51 @@ namespace memsess::core {
 
             &itemMonitoringTotalFreeSessions,
 
-            &itemEnd
+            &itemMonitoringCountShards,
         };
-        Serialization::Item *listFinal[] = { &itemValueFinal, &itemEnd };
-
-        unsigned int localDataLength = 0;
-        std::unique_ptr<char[]> localData;
+        Serialization::Item **list = listNone;
 
-        if( !initCmd( cmd ) ) {
+        if( !initCmd( cmd ) || ( isMs && !isLifetimeCmd( cmd ) ) ) {
             itemResult.value_char = WRONG_COMMAND;
-            localData = Serialization::pack( ( const Serialization::Item **)listNone, localDataLength );
-
-            itemValueFinal.length = localDataLength;
-            itemValueFinal.value_string = localData.get();
-            return Serialization::pack( ( const Serialization::Item **)listFinal, resultLength );
+            packResult( listNone, result, resultLength );
+            return;
         }
 
         if( !initParams( data, length, params ) ) {
             itemResult.value_char = WRONG_PARAMS;
-            localData = Serialization::pack( ( const Serialization::Item **)listNone, localDataLength );
-
-            itemValueFinal.length = localDataLength;
-            itemValueFinal.value_string = localData.get();
-            return Serialization::pack( ( const Serialization::Item **)listFinal, resultLength );
+            packResult( listNone, result, resultLength );
+            return;
         }
 
         if( !isNoUUIDCmd( cmd ) ) {
-            UUID::toNormal( params.uuidRaw, uuid );
+            sessionId = SessionId::fromRaw( params.uuidRaw );
         }
 
+        lifetime = isMs ? params.lifetime : params.lifetime * MS_PER_SEC;
+
         switch( cmd ) {
             case Commands::GENERATE:
-                res = _store->generate( params.lifetime, uuid );
-                UUID::toBin( uuid, uuidRaw );
+                res = _store->generate( lifetime, sessionId );
+                sessionId.toRaw( uuidRaw );
                 break;
             case Commands::EXIST:
-                res = _store->exist( uuid );
+                res = _store->exist( sessionId );
                 break;
             case Commands::REMOVE:
-                _store->remove( uuid );
+                _store->remove( sessionId );
                 break;
             case Commands::PROLONG:
-                res = _store->prolong( uuid, params.lifetime );
+                res = _store->prolong( sessionId, lifetime );
                 break;
             case Commands::ADD_KEY:
                 res = _store->addKey(
-                    uuid,
+                    sessionId,
                     params.key,
                     params.data,
                     params.dataLength,
                     counterKeys,
                     counterRecord,
-                    params.lifetime
+                    lifetime
                 );
                 break;
             case Commands::ALL_ADD_KEY:
@@ -874,20 +1118,23 @@ namespace memsess::core {
                 );
                 break;
             case Commands::GET_KEY:
-                res = _store->getKey( uuid, params.key, value, counterKeys, counterRecord, params.limitRead );
+                res = _store->getKey( sessionId, params.key, value, counterKeys, counterRecord, params.limitRead );
+                break;
+            case Commands::GET_COMPRESSED_KEY:
+                res = _store->getKey( sessionId, params.key, value, counterKeys, counterRecord, params.limitRead, true );
                 break;
             case Commands::REMOVE_KEY:
-                res = _store->removeKey( uuid, params.key );
+                res = _store->removeKey( sessionId, params.key );
                 break;
             case Commands::ALL_REMOVE_KEY:
                 res = _store->removeAllKey( params.key );
                 break;
             case Commands::EXIST_KEY:
-                res = _store->existKey( uuid, params.key );
+                res = _store->existKey( sessionId, params.key );
                 break;
             case Commands::SET_KEY:
                 res = _store->setKey(
-                    uuid,
+                    sessionId,
                     params.key,
                     params.data,
                     params.dataLength,
@@ -897,17 +1144,32 @@ namespace memsess::core {
                 );
                 break;
             case Commands::SET_FORCE_KEY:
-                res = _store->setForceKey( uuid, params.key, params.data, params.dataLength, params.limitWrite );
+                res = _store->setForceKey( sessionId, params.key, params.data, params.dataLength, params.limitWrite );
                 break;
             case Commands::PROLONG_KEY:
-                res = _store->prolongKey( uuid, params.key, params.lifetime );
+                res = _store->prolongKey( sessionId, params.key, lifetime );
                 break;
             case Commands::ADD_SESSION:
-                res = _store->add( uuid, params.lifetime );
+                res = _store->add( sessionId, lifetime );
                 break;
             case Commands::GET_STATISTICS:
                 _monitoring->getData( monitoringData );
                 break;
+            case Commands::SET_TAG:
+                res = _store->setTag( sessionId, params.tag );
+                break;
+            case Commands::TAG_REMOVE:
+                res = _store->removeByTag( params.tag, count );
+                break;
+            case Commands::TAG_PROLONG:
+                res = _store->prolongByTag( params.tag, lifetime, count );
+                break;
+            case Commands::TAG_LIST:
+                res = _store->listByTag( params.tag, sessions );
+                break;
+            case Commands::SCAN:
+                cursor = _store->scan( params.cursor, params.count, params.isKeys, scanItems );
+                break;
         }
 
         itemResult.value_char = res;
@@ -916,25 +1178,93 @@ namespace memsess::core {
 
         if( res != StoreInterface::OK ) {
             itemResult.value_char = error;
-            localData = Serialization::pack( ( const Serialization::Item **)listNone, localDataLength );
         } else {
             itemResult.value_char = OK;
 
             if( cmd == Commands::GENERATE ) {
                 itemUUID.value_string = uuidRaw;
-                localData = Serialization::pack( ( const Serialization::Item **)listGenerate, localDataLength );
+                list = listGenerate;
+            } else if( cmd == Commands::TAG_REMOVE || cmd == Commands::TAG_PROLONG ) {
+                itemCount.value_int = count;
+                list = listTagCount;
+            } else if( cmd == Commands::TAG_LIST ) {
+                sessionsRaw.resize( sessions.size() * UUID::LENGTH_RAW );
+
+                for( unsigned int i = 0; i < sessions.size(); i++ ) {
+                    sessions[i].toRaw( &sessionsRaw[i * UUID::LENGTH_RAW] );
+                }
+
+                itemCount.value_int = sessions.size();
+                itemSessions.value_string = sessionsRaw.data();
+                itemSessions.length = sessionsRaw.size();
+                list = listTagList;
+            } else if( cmd == Commands::SCAN ) {
+                unsigned long int countItems = 0;
+
+                for( auto &item : scanItems ) {
+                    countItems += params.isKeys ? 3 + item.keys.size() : 2;
+                }
+
+                sessionsRaw.resize( scanItems.size() * UUID::LENGTH_RAW );
+                itemsScan.resize( countItems );
+                listScan.reserve( countItems + 4 );
+
+                itemCursor.value_long_int = cursor;
+                itemCount.value_int = scanItems.size();
+                listScan.push_back( &itemResult );
+                listScan.push_back( &itemCursor );
+                listScan.push_back( &itemCount );
+
+                auto itemScan = itemsScan.data();
+
+                for( unsigned int i = 0; i < scanItems.size(); i++ ) {
+                    scanItems[i].id.toRaw( &sessionsRaw[i * UUID::LENGTH_RAW] );
+
+                    itemScan->type = Serialization::FIXED_STRING;
+                    itemScan->value_string = &sessionsRaw[i * UUID::LENGTH_RAW];
+                    itemScan->length = UUID::LENGTH_RAW;
+                    listScan.push_back( itemScan++ );
+
+                    itemScan->type = Serialization::LONG_INT;
+                    itemScan->value_long_int = scanItems[i].ttl;
+                    listScan.push_back( itemScan++ );
+
+                    if( !params.isKeys ) {
+                        continue;
+                    }
+
+                    itemScan->type = Serialization::INT;
+                    itemScan->value_int = scanItems[i].keys.size();
+                    listScan.push_back( itemScan++ );
+
+                    for( auto key : scanItems[i].keys ) {
+                        itemScan->type = Serialization::STRING_WITH_NULL;
+                        itemScan->value_string = _store->getKeyName( key ).data();
+                        listScan.push_back( itemScan++ );
+                    }
+                }
+
+                listScan.push_back( &itemEnd );
+                list = listScan.data();
             } else if( cmd == Commands::ADD_KEY ) {
                 itemCounterKeys.value_int = counterKeys;
                 itemCounterRecord.value_int = counterRecord;
-                localData = Serialization::pack( ( const Serialization::Item **)listAddKey, localDataLength );
-            } else if( cmd == Commands::GET_KEY ) {
+                list = listAddKey;
+            } else if( cmd == Commands::GET_KEY || cmd == Commands::GET_COMPRESSED_KEY ) {
+                auto listTail = cmd == Commands::GET_KEY ? listGetKeyTail : listGetCompressedKeyTail;
+
                 itemCounterKeys.value_int = counterKeys;
                 itemCounterRecord.value_int = counterRecord;
-                itemValue.value_string = value.c_str();
-                itemValue.length = value.length();
+                itemValueLength.value_int = value.getLength();
+                itemValueLengthOriginal.value_int = value.getLengthOriginal();
+
+                packResult( listGetKeyHead, listTail, value.getLength(), result, resultLength, payloadOffset );
+                payload = std::move( value );
 
-                localData = Serialization::pack( ( const Serialization::Item **)listGetKey, localDataLength );
+                return;
             } else if( cmd == Commands::GET_STATISTICS ) {
+                listGetStatics.assign( std::begin( listGetStaticsHead ), std::end( listGetStaticsHead ) );
+
                 itemMonitoringSendedBytes.value_long_int = monitoringData.traffic.sendedBytes;
                 itemMonitoringReceivedBytes.value_long_int = monitoringData.traffic.receivedBytes;
 
@@ -1013,21 +1343,82 @@ namespace memsess::core {
 
                 itemMonitoringTotalFreeSessions.value_long_int = monitoringData.totalFreeSessions;
 
+                itemMonitoringCountShards.value_int = monitoringData.shardSessions.size();
+                itemsMonitoringShardSessions.resize( monitoringData.shardSessions.size() );
 
+                for( unsigned int i = 0; i < monitoringData.shardSessions.size(); i++ ) {
+                    itemsMonitoringShardSessions[i].type = Serialization::LONG_INT;
+                    itemsMonitoringShardSessions[i].value_long_int = monitoringData.shardSessions[i];
+                    listGetStatics.push_back( &itemsMonitoringShardSessions[i] );
+                }
+
+                itemMonitoringCountSlabs.value_int = monitoringData.slabs.size();
+                listGetStatics.push_back( &itemMonitoringCountSlabs );
+                itemsMonitoringSlabs.resize( monitoringData.slabs.size() * 4 );
+
+                for( unsigned int i = 0; i < monitoringData.slabs.size(); i++ ) {
+                    auto items = &itemsMonitoringSlabs[i * 4];
 
+                    items[0].type = Serialization::INT;
+                    items[0].value_int = monitoringData.slabs[i].size;
+                    items[1].type = Serialization::LONG_INT;
+                    items[1].value_long_int = monitoringData.slabs[i].slabs;
+                    items[2].type = Serialization::LONG_INT;
+                    items[2].value_long_int = monitoringData.slabs[i].bytesLive;
+                    items[3].type = Serialization::LONG_INT;
+                    items[3].value_long_int = monitoringData.slabs[i].bytesWasted;
+
+                    for( unsigned int j = 0; j < 4; j++ ) {
+                        listGetStatics.push_back( &items[j] );
+                    }
+                }
 
-                localData = Serialization::pack( ( const Serialization::Item **)listGetStatics, localDataLength );
-            } else {
-                localData = Serialization::pack( ( const Serialization::Item **)listNone, localDataLength );
+                itemMonitoringMemoryLimit.value_long_int = monitoringData.memory.limit;
+                itemMonitoringMemoryBytes.value_long_int = monitoringData.memory.bytes;
+                itemMonitoringEvictions.value_long_int = monitoringData.memory.evictions;
+                itemMonitoringBytesEvicted.value_long_int = monitoringData.memory.bytesEvicted;
+                itemMonitoringBytesStored.value_long_int = monitoringData.memory.bytesStored;
+                itemMonitoringBytesLogical.value_long_int = monitoringData.memory.bytesLogical;
+                itemMonitoringBytesLocks.value_long_int = monitoringData.memory.bytesLocks;
+                itemMonitoringBytesPooled.value_long_int = monitoringData.memory.bytesPooled;
+                itemMonitoringBytesShared.value_long_int = monitoringData.memory.bytesShared;
+                itemMonitoringBytesReclaimed.value_long_int = monitoringData.memory.bytesReclaimed;
+                itemMonitoringAllocations.value_long_int = monitoringData.memory.allocations;
+                itemMonitoringBytesLog.value_long_int = monitoringData.memory.bytesLog;
+                itemMonitoringBytesLogLive.value_long_int = monitoringData.memory.bytesLogLive;
+                itemMonitoringMaintenanceJobs.value_long_int = monitoringData.maintenance.jobs;
+                itemMonitoringMaintenanceDuration.value_long_int = monitoringData.maintenance.duration;
+                itemMonitoringMaintenanceDurationMax.value_long_int = monitoringData.maintenance.durationMax;
+                itemMonitoringMaintenanceQueue.value_long_int = monitoringData.maintenance.queue;
+                listGetStatics.push_back( &itemMonitoringMemoryLimit );
+                listGetStatics.push_back( &itemMonitoringMemoryBytes );
+                listGetStatics.push_back( &itemMonitoringEvictions );
+                listGetStatics.push_back( &itemMonitoringBytesEvicted );
+                listGetStatics.push_back( &itemMonitoringBytesStored );
+                listGetStatics.push_back( &itemMonitoringBytesLogical );
+                listGetStatics.push_back( &itemMonitoringBytesLocks );
+                listGetStatics.push_back( &itemMonitoringBytesPooled );
+                listGetStatics.push_back( &itemMonitoringBytesShared );
+                listGetStatics.push_back( &itemMonitoringBytesReclaimed );
+                listGetStatics.push_back( &itemMonitoringAllocations );
+                listGetStatics.push_back( &itemMonitoringBytesLog );
+                listGetStatics.push_back( &itemMonitoringBytesLogLive );
+                listGetStatics.push_back( &itemMonitoringMaintenanceJobs );
+                listGetStatics.push_back( &itemMonitoringMaintenanceDuration );
+                listGetStatics.push_back( &itemMonitoringMaintenanceDurationMax );
+                listGetStatics.push_back( &itemMonitoringMaintenanceQueue );
+
+                listGetStatics.push_back( &itemEnd );
+
+                list = listGetStatics.data();
             }
         }
 
-        itemValueFinal.length = localDataLength;
-        itemValueFinal.value_string = localData.get();
-        return Serialization::pack( ( const Serialization::Item **)listFinal, resultLength );
+        packResult( list, result, resultLength );
     }
 
-    void ServerController::interval() {
+    template<typename Store, typename Monitoring>
+    void ServerController<Store, Monitoring>::interval() {
         _store->clearInactive();
     }
 }
@@ -2,107 +2,289 @@
 #define MEMSESS_CORE_STORE_ST
 
 #include <memory>
-#include <unordered_map>
-
-#if MEMSESS_MULTI
+#include <functional>
 #include <mutex>
 #include <shared_mutex>
 #include <atomic>
-#endif
+#include <thread>
 
 #include <string>
+#include <string_view>
 #include <string.h>
 #include <time.h>
+#include <random>
+#include <vector>
+#include <stdlib.h>
+#include <malloc.h>
 #include "../interfaces/store_interface.h"
 #include "../interfaces/monitoring_interface.h"
-#include "../util/uuid.hpp"
-
-#if MEMSESS_MULTI
-#include "../util/lock_atomic.hpp"
-#endif
+#include "../util/session_id.hpp"
+#include "../util/flat_map.hpp"
+#include "../util/small_map.hpp"
+#include "../util/epoch.hpp"
+#include "../util/payload.hpp"
+#include "../util/timing_wheel.hpp"
+#include "../util/slab.hpp"
+#include "../util/token_bucket.hpp"
+#include "../util/lz.hpp"
+#include "../util/time.hpp"
+#include "../util/clock.hpp"
+#include "../util/symbols.hpp"
+#include "../util/pool.hpp"
+#include "../util/lock_table.hpp"
+#include "../util/value_log.hpp"
+#include "../util/allocations.hpp"
+#include "../util/executor.hpp"
 
 
 namespace memsess::core {
-    class Store: public i::StoreInterface {
+    template<typename Policy, typename Monitoring>
+    class Store final: public i::StoreInterface {
 
         public:
-            struct LimiterValue {
-                unsigned long int ts;
-                unsigned short int count;
-            };
-            struct Limiter {
-                std::unordered_map<unsigned short int, LimiterValue> values;
-#if MEMSESS_MULTI
-                std::mutex m;
-#endif
-            };
- 
+            static const unsigned int SIZE_INLINE = util::PayloadRef::SIZE_INLINE;
+
+            typedef typename Policy::Lock Lock;
+            typedef typename Policy::Mutex Mutex;
+            typedef util::Slab<Policy> Slab;
+            typedef util::Symbols<Policy> Symbols;
+            typedef util::TokenBucket<Policy> TokenBucket;
+
+            template<typename T>
+            using Atomic = typename Policy::template Atomic<T>;
+
             struct Value {
-                std::string value;
-#if MEMSESS_MULTI
-                std::atomic_uint writers;
-                std::shared_timed_mutex m;
-#endif
-                unsigned long int tsEnd;
+                KeyId key;
+                unsigned int length;
+                char *data;
+                util::Payload *payload;
+                Atomic<unsigned int> seq;
                 unsigned int counterRecord;
-                std::unique_ptr<Limiter> limiterRead;
-                std::unique_ptr<Limiter> limiterWrite;
+                unsigned long int tsEnd;
+                unsigned long int generation;
+                Value *next;
+                TokenBucket limiterRead;
+                TokenBucket limiterWrite;
+                bool isGlobal;
+                bool isRemoved;
+                bool isPooled;
+                bool isLogged;
+                char inlineData[SIZE_INLINE];
             };
  
+            struct ValueKey {
+                KeyId operator()( Value *val ) const;
+            };
+
+            typedef util::SmallMap<Value *, typename Symbols::Hash, ValueKey> Values;
+
+            struct Tag;
+
             struct Item {
-                std::unordered_map<std::string, std::unique_ptr<Value>> values;
-#if MEMSESS_MULTI
-                std::atomic_uint writers;
-                std::shared_timed_mutex m;
-#endif
+                util::SessionId id;
+                Values values;
+                Atomic<unsigned long int> tsAccess;
+                Atomic<unsigned char> frequency;
                 unsigned int counterKeys;
                 unsigned long int tsEnd;
+                unsigned long int generation;
+                Tag *tag;
+                unsigned int indexTag;
+            };
+
+            struct ItemKey {
+                const util::SessionId &operator()( Item *item ) const;
+            };
+ 
+            struct Global {
+                KeyId key;
+                std::atomic<Value *> head;
+                std::atomic<unsigned long int> generationRemoved;
+            };
+
+            struct GlobalKey {
+                KeyId operator()( Global *global ) const;
+            };
+
+            typedef util::FlatMap<KeyId, Global *, typename Symbols::Hash, GlobalKey> Globals;
+
+            struct Tag {
+                std::string name;
+                std::vector<Item *> sessions;
+            };
+
+            struct TagKey {
+                std::string_view operator()( Tag *tag ) const;
+            };
+
+            typedef util::FlatMap<std::string_view, Tag *, std::hash<std::string_view>, TagKey> Tags;
+
+            struct Expiration {
+                util::SessionId sessionId;
+                bool isKey;
+                KeyId key;
+            };
+ 
+            struct Shard {
+                util::FlatMap<util::SessionId, Item *, util::SessionId::Hash, ItemKey> list;
+                Lock m;
+                Mutex mExpirations;
+                util::TimingWheel<Expiration> expirations;
+                Slab slab;
+                unsigned int count = 0;
             };
  
         private:
-            std::unordered_map<std::string, std::unique_ptr<Item>> _list;
-#if MEMSESS_MULTI
-            std::atomic_uint _writers{0};
-            std::shared_timed_mutex _m;
-#endif
+            const unsigned int COUNT_EXPIRE_BATCH = 256;
+            const unsigned int DURATION_EXPIRE_MS = 10;
+            const unsigned int DURATION_WHEEL_TICK_MS = 1'000;
+            const unsigned int COUNT_EVICT_SAMPLES = 5;
+            const unsigned int COUNT_EVICT_PROBE = 64;
+            const unsigned int COUNT_EVICT_BATCH = 64;
+            const unsigned int FREQUENCY_INIT = 5;
+            const unsigned int FREQUENCY_MAX = 255;
+            const unsigned int FREQUENCY_FACTOR = 10;
+            const unsigned int DURATION_FREQUENCY_DECAY_MS = 60'000;
+            const unsigned int BITS_LOCKS = Policy::IS_MULTI ? 10 : 1;
+            const unsigned int COUNT_TIER_BATCH = 4'096;
+            const unsigned int COUNT_PURGE_BATCH = 4'096;
+            const unsigned int COUNT_SWEEP_SHARDS = 8;
+            const unsigned int BITS_SCAN_POSITION = 40;
+
+            unsigned int _indexShardCompact = 0;
+            unsigned int _indexShardTier = 0;
+            unsigned long int _indexItemTier = 0;
+            unsigned int _indexShardPurge = 0;
+            unsigned long int _positionPurge = 0;
+            unsigned long int _generationPass = 0;
+            unsigned long int _generationPurged = 0;
+            Atomic<unsigned long int> _generationPurge{0};
+            std::vector<Item *> _sessionsPurge;
+            std::vector<KeyId> _keysPurge;
+            bool _isTrim = false;
+            std::unique_ptr<Shard[]> _shards;
+            unsigned int _countShards;
             unsigned int _limit;
-            unsigned int _count = 0;
-            i::MonitoringInterface *_monitoring;
-#if MEMSESS_MULTI
-            void _wait( std::atomic_uint &atom );
-#endif
+            unsigned long int _memory = 0;
+            Eviction _eviction = EVICTION_LRU;
+            unsigned int _compression = 0;
+            unsigned int _deduplication = 0;
+            unsigned int _logThreshold = 0;
+            unsigned long int _logIdle = 0;
+            Globals _globals;
+            Symbols _symbols;
+            util::Pool<Policy> _pool;
+            util::ValueLog<Policy> _log;
+            Lock _mGlobals;
+            Tags _tags;
+            Mutex _mTags;
+            util::LockTable<Lock> _locksItems{ BITS_LOCKS };
+            util::LockTable<Lock> _locksValues{ BITS_LOCKS };
+            Atomic<unsigned int> _countSweep{0};
+            unsigned long int _tsSweep = 0;
+            util::Executor _executor;
+            Atomic<unsigned long int> _generation{1};
+            Atomic<unsigned int> _count{0};
+            Atomic<unsigned long int> _bytes{0};
+            Atomic<unsigned long int> _bytesStored{0};
+            Atomic<unsigned long int> _bytesLogical{0};
+            Atomic<unsigned long int> _bytesShared{0};
+            Monitoring *_monitoring;
+            Shard *_getShard( const util::SessionId &sessionId );
+            Lock &_getLock( Item *sess );
+            Lock &_getLock( Value *val );
+            Item *_getSession( Shard *shard, const util::SessionId &sessionId );
+            Item *_createSession( Shard *shard, const util::SessionId &sessionId );
+            unsigned long int _deleteSession( Shard *shard, Item *sess );
+            Value *_createValue( Shard *shard, KeyId key, const char *data, unsigned int length );
+            Value *_copyValue( Shard *shard, Value *src );
+            Value *_materialize( Shard *shard, Item *sess, KeyId key );
+            Global *_getGlobal( KeyId key );
+            void _removeGlobalValues( Value *val );
+            void _untag( Item *sess );
+            void _getTagged( std::string_view tag, std::vector<util::SessionId> &sessions );
+            void _setData( Shard *shard, Value *val, const char *data, unsigned int length );
+            void _setValue( Shard *shard, Value *val, const char *data, unsigned int length );
+            void _readValue( Value *val, util::PayloadRef &value, unsigned int &counterRecord );
+            void _decompress( util::PayloadRef &value );
+            void _insertValue( Item *sess, Value *val );
+            void _deleteValue( Shard *shard, Value *val );
+            static void _freeSession( void *shard, void *sess, unsigned int );
+            static void _freeValue( void *shard, void *val, unsigned int );
+            static void _freeGlobalValue( void *, void *val, unsigned int );
+            static void _freeGlobal( void *, void *global, unsigned int );
+            static void _freeData( void *shard, void *payload, unsigned int size );
+            static void _freeHeap( void *, void *payload, unsigned int );
+            void _updateMonitoringMemory();
+            unsigned long int _getSizeValue( Value *val );
+            void _incBytes( unsigned long int bytes );
+            void _decBytes( unsigned long int bytes );
+            void _incValueBytes( Value *val );
+            unsigned long int _decValueBytes( Value *val );
+            bool _isOverMemory();
+            void _touch( Item *sess );
+            unsigned int _getFrequency( Item *sess, unsigned long int msCur );
+            bool _isBetterEviction( Item *sess, Item *other, unsigned long int msCur );
+            Item *_sampleEviction( Shard *&shard );
+            void _reclaim();
+            static unsigned long int _random();
+            unsigned int _getIndexShard( Shard *shard );
+            bool _incCount();
+            void _decCount( Shard *shard );
+            bool _clearInactive( Shard *shard, unsigned long int tsCur );
+            void _sweep( unsigned int index );
+            void _finishSweep();
+            void _compact();
+            void _tier();
+            void _spill( Value *val, bool isIdle );
+            void _purge();
+            void _purgeValues( Shard *shard, Item *sess );
+            void _purgeGlobals( unsigned long int generation );
+            bool _expire( Shard *shard, unsigned long int tsCur, unsigned int limit );
+            void _addExpiration(
+                Shard *shard,
+                const util::SessionId &sessionId,
+                KeyId key,
+                unsigned long int tsEnd
+            );
             unsigned long int getTime();
-            bool incLimiter( Limiter *limiter, unsigned short int limit );
             bool checkActualTs( unsigned long int ts );
             bool checkChildTs( unsigned long int parentTs, unsigned long int keyLifetime );
-            Value *_getKey(
-                std::unordered_map<std::string, std::unique_ptr<Value>> &values,
-                const char *name
-            );
+            Value *_getKey( Item *sess, KeyId key );
  
         public:
-            Store( i::MonitoringInterface *monitoring );
-            Result add( const char *sessionId, unsigned int lifetime = 0 );
-            Result generate( unsigned int lifetime, char *sessionId );
-            Result exist( const char *sessionId );
+            Store( Monitoring *monitoring, unsigned int countShards = 1 );
+            ~Store();
+            Result add( const util::SessionId &sessionId, unsigned long int lifetime = 0 );
+            Result generate( unsigned long int lifetime, util::SessionId &sessionId );
+            Result exist( const util::SessionId &sessionId );
             void setLimit( unsigned int limit );
-            void remove( const char *sessionId );
-            Result prolong( const char *sessionId, unsigned int lifetime );
+            void setLimitKeys( unsigned int limit );
+            void setMemory( unsigned long int memory, Eviction eviction = EVICTION_LRU );
+            void setCompression( unsigned int threshold );
+            void setDeduplication( unsigned int threshold );
+            bool setLog( const std::string &path, unsigned int threshold, unsigned long int idle );
+            void setMaintenance( unsigned int countThreads );
+            void reserve( unsigned long int count );
+            KeyId getKeyId( std::string_view key, bool isCreate = false );
+            std::string_view getKeyName( KeyId key );
+            void remove( const util::SessionId &sessionId );
+            Result prolong( const util::SessionId &sessionId, unsigned long int lifetime );
          
             Result addKey(
-                const char *sessionId,
-                const char *key,
+                const util::SessionId &sessionId,
+                KeyId key,
                 const char *value,
                 unsigned int length,
                 unsigned int &counterKeys,
                 unsigned int &counterRecord,
-                unsigned int lifetime = 0
+                unsigned long int lifetime = 0
             );
-            Result existKey( const char *sessionId, const char *key );
-            Result prolongKey( const char *sessionId, const char *key, unsigned int lifetime );
+            Result existKey( const util::SessionId &sessionId, KeyId key );
+            Result prolongKey( const util::SessionId &sessionId, KeyId key, unsigned long int lifetime );
             Result setKey(
-                const char *sessionId,
-                const char *key,
+                const util::SessionId &sessionId,
+                KeyId key,
                 const char *value,
                 unsigned int length,
                 unsigned int counterKeys,
@@ -110,587 +292,1801 @@ namespace memsess::core {
                 unsigned short int limit = 0
             );
             Result setForceKey(
-                const char *sessionId,
-                const char *key,
+                const util::SessionId &sessionId,
+                KeyId key,
                 const char *value,
                 unsigned int length,
                 unsigned short int limit = 0
             );
             Result getKey(
-                const char *sessionId,
-                const char *key,
-                std::string &value,
+                const util::SessionId &sessionId,
+                KeyId key,
+                util::PayloadRef &value,
                 unsigned int &counterKeys,
                 unsigned int &counterRecord,
-                unsigned short int limit = 0
+                unsigned short int limit = 0,
+                bool isCompressed = false
             );
-            Result removeKey( const char *sessionId, const char *key );
+            Result removeKey( const util::SessionId &sessionId, KeyId key );
          
             void clearInactive();
             Result addAllKey(
-                const char *key,
+                KeyId key,
                 const char *value,
                 unsigned int length
             );
-            Result removeAllKey( const char *key );
+            Result removeAllKey( KeyId key );
+            Result setTag( const util::SessionId &sessionId, std::string_view tag );
+            Result removeByTag( std::string_view tag, unsigned int &count );
+            Result prolongByTag( std::string_view tag, unsigned long int lifetime, unsigned int &count );
+            Result listByTag( std::string_view tag, std::vector<util::SessionId> &sessions );
+            unsigned long int scan( unsigned long int cursor, unsigned int count, bool isKeys, std::vector<ScanItem> &items );
     };
 
-    unsigned long int Store::getTime() {
-        return time( NULL );
+    template<typename Policy, typename Monitoring>
+    unsigned long int Store<Policy, Monitoring>::getTime() {
+        return util::Clock::getMs();
     }
 
-    Store::Store( i::MonitoringInterface *monitoring ) {
+    template<typename Policy, typename Monitoring>
+    Store<Policy, Monitoring>::Store( Monitoring *monitoring, unsigned int countShards ) {
         _monitoring = monitoring;
-    }
+        _countShards = countShards == 0 ? 1 : countShards;
+        _shards = std::make_unique<Shard[]>( _countShards );
 
-#if MEMSESS_MULTI
-    void Store::_wait( std::atomic_uint &atom ) {
-        while( atom );
-    }
-#endif
+        auto tsCur = getTime();
 
-    Store::Result Store::add( const char *sessionId, unsigned int lifetime ) {
-#if MEMSESS_MULTI
-        util::LockAtomic lock( _writers );
-        std::lock_guard<std::shared_timed_mutex> lockList( _m );
-#endif
-        if( ( _count == _limit && _limit != 0 ) || _count == 0xFF'FF'FF'FF ) {
-            return Result::E_LIMIT_EXCEEDED;
+        for( unsigned int i = 0; i < _countShards; i++ ) {
+            _shards[i].expirations = util::TimingWheel<Expiration>( tsCur / DURATION_WHEEL_TICK_MS );
         }
 
-        if( _list.find( sessionId ) != _list.end() && checkActualTs( _list[sessionId]->tsEnd ) ) {
-            return Result::E_DUPLICATE_SESSION;
+        _monitoring->setCountShards( _countShards );
+
+        if constexpr( Policy::IS_MULTI ) {
+            _monitoring->setLockBytes(
+                _locksItems.getBytes() + _locksValues.getBytes() +
+                sizeof( _mGlobals ) + _countShards * ( sizeof( Lock ) + sizeof( Mutex ) )
+            );
         }
+    }
 
-        auto item = std::make_unique<Item>();
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Shard *Store<Policy, Monitoring>::_getShard( const util::SessionId &sessionId ) {
+        auto hash = util::SessionId::Hash{}( sessionId );
 
-        if( lifetime != 0 ) {
-            item->tsEnd = getTime() + lifetime;
-        }
+        return &_shards[( hash >> 7 ) % _countShards];
+    }
 
-        _list[sessionId] = std::move( item );
-        _count++;
-        _monitoring->updateTotalFreeSessions( _limit -_count );
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Lock &Store<Policy, Monitoring>::_getLock( Item *sess ) {
+        return _locksItems.get( sess );
+    }
 
-        return Result::OK;
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Lock &Store<Policy, Monitoring>::_getLock( Value *val ) {
+        return _locksValues.get( val );
     }
 
-    Store::Result Store::generate( unsigned int lifetime, char *sessionId ) {
-#if MEMSESS_MULTI
-        util::LockAtomic lock( _writers );
-        std::lock_guard<std::shared_timed_mutex> lockList( _m );
-#endif
-        if( ( _count == _limit && _limit != 0 ) || _count == 0xFF'FF'FF'FF ) {
-            return Result::E_LIMIT_EXCEEDED;
-        }
+    template<typename Policy, typename Monitoring>
+    Store<Policy, Monitoring>::~Store() {
+        _executor.stop();
 
-        while( true ) {
-            util::UUID::generate( sessionId );
+        for( unsigned int i = 0; i < _countShards; i++ ) {
+            auto shard = &_shards[i];
 
-            if( _list.find( sessionId ) == _list.end() ) {
-                break;
+            for( unsigned long int j = 0; j < shard->list.capacity(); j++ ) {
+                if( shard->list.isFull( j ) ) {
+                    _freeSession( shard, shard->list.getValue( j ), 0 );
+                }
             }
         }
 
-        auto item = std::make_unique<Item>();
+        for( unsigned long int i = 0; i < _globals.capacity(); i++ ) {
+            if( _globals.isFull( i ) ) {
+                auto global = _globals.getValue( i );
 
-        if( lifetime != 0 ) {
-            item->tsEnd = getTime() + lifetime;
+                _removeGlobalValues( global->head );
+                delete global;
+            }
         }
 
-        _list[sessionId] = std::move( item );
-        _count++;
-        _monitoring->updateTotalFreeSessions( _limit -_count );
+        for( unsigned long int i = 0; i < _tags.capacity(); i++ ) {
+            if( _tags.isFull( i ) ) {
+                delete _tags.getValue( i );
+            }
+        }
 
-        return Result::OK;
+        util::Epoch::collect();
     }
 
-    Store::Result Store::exist( const char *sessionId ) {
-#if MEMSESS_MULTI
-        _wait( _writers );
-        std::shared_lock<std::shared_timed_mutex> lockList( _m );
-#endif
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::KeyId Store<Policy, Monitoring>::ValueKey::operator()( Value *val ) const {
+        return val->key;
+    }
 
-        if( _list.find( sessionId ) != _list.end() && checkActualTs( _list[sessionId]->tsEnd ) ) {
-            return Result::OK;
-        }
+    template<typename Policy, typename Monitoring>
+    const util::SessionId &Store<Policy, Monitoring>::ItemKey::operator()( Item *item ) const {
+        return item->id;
+    }
 
-        return Result::E_SESSION_NONE;
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::KeyId Store<Policy, Monitoring>::GlobalKey::operator()( Global *global ) const {
+        return global->key;
     }
 
-    void Store::setLimit( unsigned int limit ) {
-#if MEMSESS_MULTI
-        util::LockAtomic lock( _writers );
-        std::lock_guard<std::shared_timed_mutex> lockList( _m );
-#endif
+    template<typename Policy, typename Monitoring>
+    std::string_view Store<Policy, Monitoring>::TagKey::operator()( Tag *tag ) const {
+        return tag->name;
+    }
 
-        if( limit == 0 ) {
-            _count = 0;
-        }
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Item *Store<Policy, Monitoring>::_createSession( Shard *shard, const util::SessionId &sessionId ) {
+        auto sess = shard->slab.template create<Item>();
 
-        _limit = limit;
-        _monitoring->updateTotalFreeSessions( _limit );
+        sess->id = sessionId;
+        sess->generation = _generation;
+        sess->tsAccess = getTime();
+        sess->frequency = FREQUENCY_INIT;
+        sess->tag = nullptr;
+        _incBytes( sizeof( Item ) + sess->values.getBytes() );
+
+        return sess;
     }
 
-    void Store::remove( const char *sessionId ) {
-#if MEMSESS_MULTI
-        _wait( _writers );
-        std::shared_lock<std::shared_timed_mutex> lockList( _m );
-#endif
+    template<typename Policy, typename Monitoring>
+    unsigned long int Store<Policy, Monitoring>::_deleteSession( Shard *shard, Item *sess ) {
+        unsigned long int bytes = sizeof( Item ) + sess->values.getBytes();
 
-        if( _list.find( sessionId ) == _list.end() || !checkActualTs( _list[sessionId]->tsEnd ) ) {
-            return;
+        _decBytes( bytes );
+
+        if( sess->tag != nullptr ) {
+            std::lock_guard<Mutex> lockTags( _mTags );
+            _untag( sess );
         }
 
-        _list[sessionId]->tsEnd = 0;
+        for( unsigned long int i = 0; i < sess->values.capacity(); i++ ) {
+            if( sess->values.isFull( i ) ) {
+                bytes += _decValueBytes( sess->values.getValue( i ) );
+            }
+        }
+
+        util::Epoch::retire( _freeSession, shard, sess );
+
+        return bytes;
     }
 
-    Store::Result Store::prolong( const char *sessionId, unsigned int lifetime ) {
-#if MEMSESS_MULTI
-        _wait( _writers );
-        std::shared_lock<std::shared_timed_mutex> lockList( _m );
-#endif
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_freeSession( void *shard, void *sess, unsigned int ) {
+        auto item = ( Item * )sess;
 
-        if( _list.find( sessionId ) == _list.end() || !checkActualTs( _list[sessionId]->tsEnd ) ) {
-            return Result::E_SESSION_NONE;
+        for( unsigned long int i = 0; i < item->values.capacity(); i++ ) {
+            if( item->values.isFull( i ) ) {
+                _freeValue( shard, item->values.getValue( i ), 0 );
+            }
         }
 
-        auto sess = _list[sessionId].get();
+        ( ( Shard * )shard )->slab.destroy( item );
+    }
 
-#if MEMSESS_MULTI
-        util::LockAtomic writersValues( sess->writers );
-        std::lock_guard<std::shared_timed_mutex> lockValues( sess->m );
-#endif
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Value *Store<Policy, Monitoring>::_createValue( Shard *shard, KeyId key, const char *data, unsigned int length ) {
+        auto val = shard->slab.template create<Value>();
 
-        if( lifetime != 0 ) {
-            sess->tsEnd = getTime() + lifetime;
-        } else {
-            sess->tsEnd = 0xFFFFFFFF;
-        }
+        val->key = key;
+        val->generation = _generation;
+        _setData( shard, val, data, length );
+        _incValueBytes( val );
 
-        return Result::OK;
+        return val;
     }
 
-    Store::Result Store::addKey(
-        const char *sessionId,
-        const char *key,
-        const char *value,
-        unsigned int length,
-        unsigned int &counterKeys,
-        unsigned int &counterRecord,
-        unsigned int lifetime
-    ) {
-        auto tsEndKey = getTime() + lifetime;
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Value *Store<Policy, Monitoring>::_copyValue( Shard *shard, Value *src ) {
+        auto val = shard->slab.template create<Value>();
 
-#if MEMSESS_MULTI
-        _wait( _writers );
-        std::shared_lock<std::shared_timed_mutex> lockList( _m );
-#endif
+        val->key = src->key;
+        val->generation = _generation;
+        val->counterRecord = src->counterRecord;
+        val->payload = src->payload;
+        val->length = src->length;
+        val->isPooled = src->isPooled;
+        val->isLogged = src->isLogged;
 
-        if( _list.find( sessionId ) == _list.end() || !checkActualTs( _list[sessionId]->tsEnd ) ) {
-            return Result::E_SESSION_NONE;
+        if( val->payload != nullptr && val->payload->acquire() ) {
+            val->data = val->payload->getData();
+        } else {
+            val->payload = nullptr;
+            val->data = val->inlineData;
+            memcpy( val->data, src->data, val->length );
         }
 
-        auto sess = _list[sessionId].get();
+        _incValueBytes( val );
 
-        if( !checkChildTs( sess->tsEnd, lifetime ) ) {
-            return Result::E_LIFETIME_EXCEEDED;
-        }
+        return val;
+    }
 
-#if MEMSESS_MULTI
-        util::LockAtomic writersValues( sess->writers );
-        std::lock_guard<std::shared_timed_mutex> lockValues( sess->m );
-#endif
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Value *Store<Policy, Monitoring>::_materialize( Shard *shard, Item *sess, KeyId key ) {
+        std::lock_guard<Lock> lockValues( _getLock( sess ) );
+        auto val = _getKey( sess, key );
 
-        if( _getKey( sess->values, key ) != nullptr ) {
-            return Result::E_DUPLICATE_KEY;
+        if( val == nullptr || !val->isGlobal ) {
+            return val;
         }
 
-        sess->counterKeys++;
-
-        auto val = std::make_unique<Value>();
-        val->value = std::string( value, length );
+        auto copy = _copyValue( shard, val );
+        auto valOld = sess->values.erase( key );
 
-        if( lifetime != 0 ) {
-            val->tsEnd = tsEndKey;
+        if( valOld != nullptr ) {
+            _deleteValue( shard, valOld );
         }
 
-        val->limiterWrite = std::make_unique<Limiter>();
-        val->limiterRead = std::make_unique<Limiter>();
-
-        counterKeys = sess->counterKeys;
-        counterRecord = 0;
-        sess->values[key] = std::move( val );
+        _insertValue( sess, copy );
 
-        return Result::OK;
+        return copy;
     }
 
-    Store::Result Store::existKey( const char *sessionId, const char *key ) {
-#if MEMSESS_MULTI
-        _wait( _writers );
-        std::shared_lock<std::shared_timed_mutex> lockList( _m );
-#endif
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Global *Store<Policy, Monitoring>::_getGlobal( KeyId key ) {
+        auto global = _globals.find( key );
 
-        if( _list.find( sessionId ) == _list.end() || !checkActualTs( _list[sessionId]->tsEnd ) ) {
-            return Result::E_SESSION_NONE;
+        if( global == nullptr ) {
+            global = new Global();
+            global->key = key;
+            _globals.insert( global );
         }
 
-        auto sess = _list[sessionId].get();
+        return global;
+    }
 
-#if MEMSESS_MULTI
-        _wait( sess->writers );
-        std::shared_lock<std::shared_timed_mutex> lockValues( sess->m );
-#endif
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_untag( Item *sess ) {
+        auto tag = sess->tag;
+        auto last = tag->sessions.back();
 
-        if( _getKey( sess->values, key ) == nullptr ) {
-            return Result::E_KEY_NONE;
-        }
+        tag->sessions[sess->indexTag] = last;
+        last->indexTag = sess->indexTag;
+        tag->sessions.pop_back();
+        sess->tag = nullptr;
 
-        return Result::OK;
+        if( tag->sessions.empty() ) {
+            _tags.erase( tag->name );
+            delete tag;
+        }
     }
 
-    Store::Result Store::prolongKey( const char *sessionId, const char *key, unsigned int lifetime ) {
-        auto tsEndKey = getTime() + lifetime;
-
-#if MEMSESS_MULTI
-        _wait( _writers );
-        std::shared_lock<std::shared_timed_mutex> lockList( _m );
-#endif
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_getTagged( std::string_view tag, std::vector<util::SessionId> &sessions ) {
+        sessions.clear();
 
-        if( _list.find( sessionId ) == _list.end() || !checkActualTs( _list[sessionId]->tsEnd ) ) {
-            return Result::E_SESSION_NONE;
+        if( tag.empty() ) {
+            return;
         }
 
-        auto sess = _list[sessionId].get();
+        std::lock_guard<Mutex> lockTags( _mTags );
+        auto item = _tags.find( tag );
 
-        if( !checkChildTs( sess->tsEnd, lifetime ) ) {
-            return Result::E_LIFETIME_EXCEEDED;
+        if( item == nullptr ) {
+            return;
         }
 
-#if MEMSESS_MULTI
-        _wait( sess->writers );
-        std::shared_lock<std::shared_timed_mutex> lockValues( sess->m );
-#endif
-        auto val = _getKey( sess->values, key );
+        sessions.reserve( item->sessions.size() );
 
-        if( val == nullptr ) {
-            return Result::E_KEY_NONE;
+        for( auto sess : item->sessions ) {
+            if( checkActualTs( sess->tsEnd ) ) {
+                sessions.push_back( sess->id );
+            }
         }
+    }
 
-#if MEMSESS_MULTI
-        util::LockAtomic writersValue( val->writers );
-        std::lock_guard<std::shared_timed_mutex> lockValue( val->m );
-#endif
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_removeGlobalValues( Value *val ) {
+        while( val != nullptr ) {
+            auto next = val->next;
 
-        if ( lifetime != 0 ) {
-            val->tsEnd = tsEndKey;
-        } else {
-            val->tsEnd = 0;
+            _decValueBytes( val );
+            util::Epoch::retire( _freeGlobalValue, nullptr, val );
+            val = next;
         }
-
-        return Result::OK;
     }
 
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_setData( Shard *shard, Value *val, const char *data, unsigned int length ) {
+        static thread_local std::vector<char> buffer;
+        unsigned int lengthOriginal = 0;
 
-    Store::Result Store::setKey(
-        const char *sessionId,
-        const char *key,
-        const char *value,
-        unsigned int length,
-        unsigned int counterKeys,
-        unsigned int counterRecord,
-        unsigned short int limit
-    ) {
-#if MEMSESS_MULTI
-        _wait( _writers );
-        std::shared_lock<std::shared_timed_mutex> lockList( _m );
-#endif
+        if( _compression != 0 && length > _compression ) {
+            buffer.resize( util::LZ::getBound( length ) );
+            auto lengthCompressed = util::LZ::compress( data, length, buffer.data() );
 
-        if( _list.find( sessionId ) == _list.end() || !checkActualTs( _list[sessionId]->tsEnd ) ) {
-            return Result::E_SESSION_NONE;
+            if( lengthCompressed < length - length / 8 ) {
+                lengthOriginal = length;
+                data = buffer.data();
+                length = lengthCompressed;
+            }
         }
 
-        auto sess = _list[sessionId].get();
-
-#if MEMSESS_MULTI
-        _wait( sess->writers );
-        std::shared_lock<std::shared_timed_mutex> lockValues( sess->m );
-#endif
+        val->length = length;
+        val->payload = nullptr;
+        val->isPooled = false;
+        val->isLogged = false;
 
-        auto val = _getKey( sess->values, key );
+        if( lengthOriginal == 0 && length <= SIZE_INLINE ) {
+            val->data = val->inlineData;
+            memcpy( val->data, data, length );
 
-        if( val == nullptr ) {
-            return Result::E_KEY_NONE;
+            return;
         }
-        
-#if MEMSESS_MULTI
-        util::LockAtomic writersValue( val->writers );
-        std::lock_guard<std::shared_timed_mutex> lockValue( val->m );
-#endif
 
-        if( val->counterRecord != counterRecord || sess->counterKeys != counterKeys ) {
-            return Result::E_RECORD_BEEN_CHANGED;
+        if( _deduplication != 0 && length >= _deduplication ) {
+            val->payload = _pool.get( data, length, lengthOriginal );
+            val->isPooled = val->payload != nullptr;
         }
 
-        if( !incLimiter( val->limiterWrite.get(), limit ) ) {
-            return Result::E_LIMIT_PER_SEC_EXCEEDED;
+        if( val->payload == nullptr && shard != nullptr && _logThreshold != 0 && length >= _logThreshold ) {
+            val->payload = _log.append( data, length, lengthOriginal );
+            val->isLogged = val->payload != nullptr;
         }
 
-        val->value = std::string( value, length );
-        val->counterRecord++;
-
-        return Result::OK;
-    }
+        if( val->payload == nullptr && shard == nullptr ) {
+            auto ptr = util::Allocations::malloc( util::Payload::getSize( length ) );
 
-    Store::Result Store::setForceKey(
-        const char *sessionId,
-        const char *key,
-        const char *value,
-        unsigned int length,
-        unsigned short int limit
-    ) {
-#if MEMSESS_MULTI
-        _wait( _writers );
-        std::shared_lock<std::shared_timed_mutex> lockList( _m );
-#endif
+            val->payload = util::Payload::create( ptr, data, length, _freeHeap, nullptr, lengthOriginal );
+        } else if( val->payload == nullptr ) {
+            auto ptr = shard->slab.allocate( util::Payload::getSize( length ) );
 
-        if( _list.find( sessionId ) == _list.end() || !checkActualTs( _list[sessionId]->tsEnd ) ) {
-            return Result::E_SESSION_NONE;
+            val->payload = util::Payload::create( ptr, data, length, _freeData, shard, lengthOriginal );
         }
 
-        auto sess = _list[sessionId].get();
+        val->data = val->payload->getData();
+    }
 
-#if MEMSESS_MULTI
-        _wait( sess->writers );
-        std::shared_lock<std::shared_timed_mutex> lockValues( sess->m );
-#endif
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_setValue( Shard *shard, Value *val, const char *data, unsigned int length ) {
+        auto payloadOld = val->payload;
 
-        auto val = _getKey( sess->values, key );
+        _decValueBytes( val );
 
-        if( val == nullptr ) {
-            return Result::E_KEY_NONE;
+        val->seq++;
+        _setData( shard, val, data, length );
+        val->counterRecord++;
+        val->seq++;
+
+        _incValueBytes( val );
+
+        if( payloadOld != nullptr ) {
+            payloadOld->release();
         }
+    }
 
-#if MEMSESS_MULTI
-        util::LockAtomic writersValue( val->writers );
-        std::lock_guard<std::shared_timed_mutex> lockValue( val->m );
-#endif
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_readValue( Value *val, util::PayloadRef &value, unsigned int &counterRecord ) {
+        if constexpr( !Policy::IS_MULTI ) {
+            if( val->payload != nullptr ) {
+                val->payload->acquire();
+                value.set( val->payload );
+            } else {
+                value.copy( val->data, val->length );
+            }
 
-        if( !incLimiter( val->limiterWrite.get(), limit ) ) {
-            return Result::E_LIMIT_PER_SEC_EXCEEDED;
+            counterRecord = val->counterRecord;
+
+            return;
         }
 
-        val->value = std::string( value, length );
-        val->counterRecord++;
+        while( true ) {
+            auto seq = val->seq.load( std::memory_order_acquire );
 
-        return Result::OK;
-    }
+            if( seq & 1 ) {
+                std::this_thread::yield();
+                continue;
+            }
 
-    Store::Result Store::getKey(
-        const char *sessionId,
-        const char *key,
-        std::string &value,
-        unsigned int &counterKeys,
-        unsigned int &counterRecord,
-        unsigned short int limit
-    ) {
-#if MEMSESS_MULTI
-        _wait( _writers );
-        std::shared_lock<std::shared_timed_mutex> lockList( _m );
-#endif
+            auto payload = val->payload;
+            auto data = val->data;
+            auto length = val->length;
+            counterRecord = val->counterRecord;
+            std::atomic_thread_fence( std::memory_order_acquire );
 
-        if( _list.find( sessionId ) == _list.end() || !checkActualTs( _list[sessionId]->tsEnd ) ) {
-            return Result::E_SESSION_NONE;
-        }
+            if( val->seq.load( std::memory_order_relaxed ) != seq ) {
+                continue;
+            }
 
-        auto sess = _list[sessionId].get();
+            if( payload != nullptr ) {
+                if( payload->acquire() ) {
+                    value.set( payload );
+                    return;
+                }
 
-#if MEMSESS_MULTI
-        _wait( sess->writers );
-        std::shared_lock<std::shared_timed_mutex> lockValues( sess->m );
-#endif
+                continue;
+            }
 
-        auto val = _getKey( sess->values, key );
+            value.copy( data, length );
+            std::atomic_thread_fence( std::memory_order_acquire );
 
-        if( val == nullptr ) {
-            return Result::E_KEY_NONE;
+            if( val->seq.load( std::memory_order_relaxed ) == seq ) {
+                return;
+            }
         }
+    }
 
-#if MEMSESS_MULTI
-        _wait( val->writers );
-        std::shared_lock<std::shared_timed_mutex> lockValue( val->m );
-#endif
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_insertValue( Item *sess, Value *val ) {
+        auto bytes = sess->values.getBytes();
 
-        if( !incLimiter( val->limiterRead.get(), limit ) ) {
-            return Result::E_LIMIT_PER_SEC_EXCEEDED;
-        }
+        sess->values.insert( val );
+        _incBytes( sess->values.getBytes() );
+        _decBytes( bytes );
+    }
 
-        value = val->value;
-        counterRecord = val->counterRecord;
-        counterKeys = sess->counterKeys;
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_deleteValue( Shard *shard, Value *val ) {
+        _decValueBytes( val );
+        util::Epoch::retire( _freeValue, shard, val );
+    }
 
-        return Result::OK;
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_freeValue( void *shard, void *val, unsigned int ) {
+        auto value = ( Value * )val;
+
+        if( value->payload != nullptr ) {
+            value->payload->release();
+        }
+
+        ( ( Shard * )shard )->slab.destroy( value );
     }
 
-    Store::Result Store::removeKey( const char *sessionId, const char *key ) {
-#if MEMSESS_MULTI
-        _wait( _writers );
-        std::shared_lock<std::shared_timed_mutex> lockList( _m );
-#endif
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_freeGlobalValue( void *, void *val, unsigned int ) {
+        auto value = ( Value * )val;
 
-        if( _list.find( sessionId ) == _list.end() || !checkActualTs( _list[sessionId]->tsEnd ) ) {
-            return Result::E_SESSION_NONE;
+        if( value->payload != nullptr ) {
+            value->payload->release();
         }
 
-        auto sess = _list[sessionId].get();
+        delete value;
+    }
 
-#if MEMSESS_MULTI
-        util::LockAtomic writersValues( sess->writers );
-        std::lock_guard<std::shared_timed_mutex> lockValues( sess->m );
-#endif
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_freeGlobal( void *, void *global, unsigned int ) {
+        delete ( Global * )global;
+    }
 
-        sess->values.erase( key );
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_freeData( void *shard, void *payload, unsigned int size ) {
+        ( ( Shard * )shard )->slab.free( payload, size );
+    }
 
-        return Result::OK;
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_freeHeap( void *, void *payload, unsigned int ) {
+        free( payload );
     }
 
-    void Store::clearInactive() {
-#if MEMSESS_MULTI
-        util::LockAtomic lock( _writers );
-        std::lock_guard<std::shared_timed_mutex> lockList( _m );
-#endif
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_decompress( util::PayloadRef &value ) {
+        auto length = value.getLengthOriginal();
+        auto payload = util::Payload::create( util::Allocations::malloc( util::Payload::getSize( length ) ), nullptr, length, _freeHeap, nullptr );
 
-        auto tsCur = getTime();
+        util::LZ::decompress( value.getData(), value.getLength(), payload->getData(), length );
+        value.set( payload );
+    }
 
-        for( auto it = _list.begin(); it != _list.end(); ) {
-            auto sess = _list[it->first].get();
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_updateMonitoringMemory() {
+        std::vector<typename Slab::Stat> stats;
+        std::vector<i::MonitoringInterface::DataSlab> slabs;
 
-            if( sess->tsEnd < tsCur && sess->tsEnd != 0 ) {
-                it = _list.erase( it );
-                _count--;
-                _monitoring->updateTotalFreeSessions( _limit -_count );
-            } else {
-                ++it;
-                for( auto itV = sess->values.begin(); itV != sess->values.end(); ) {
-                    auto val = sess->values[itV->first].get();
-                    if( val->tsEnd != 0 && val->tsEnd < tsCur ) {
-                        itV = sess->values.erase( itV );
-                    } else {
-                        ++itV;
-                    }
-                }
-            }
+        for( unsigned int i = 0; i < _countShards; i++ ) {
+            _shards[i].slab.getStats( stats );
         }
-    }
 
-    bool Store::checkActualTs( unsigned long int ts ) {
-        return ts == 0 || ts >= getTime();
+        for( auto &stat : stats ) {
+            slabs.push_back( { stat.size, stat.slabs, stat.bytesLive, stat.bytesWasted } );
+        }
+
+        _monitoring->updateSlabs( slabs );
+        _monitoring->updateMemory( _bytes + _pool.getBytes() );
+        _monitoring->updateValueBytes( _bytesStored, _bytesLogical );
+        _monitoring->updatePoolBytes( _pool.getBytes(), _bytesShared );
+        _monitoring->updateLogBytes( _log.getBytes(), _log.getBytesLive() );
     }
 
-    bool Store::checkChildTs( unsigned long int parentTs, unsigned long int keyLifetime ) {
-        auto tsEndKey = getTime() + keyLifetime;
+    template<typename Policy, typename Monitoring>
+    unsigned long int Store<Policy, Monitoring>::_getSizeValue( Value *val ) {
+        auto bytes = sizeof( Value );
 
-        if( keyLifetime != 0 && parentTs != 0 && parentTs < tsEndKey ) {
-            return false;
+        if( val->payload != nullptr && !val->isPooled && !val->isLogged ) {
+            bytes += util::Payload::getSize( val->length );
         }
 
-        return true;
+        return bytes;
     }
 
-    Store::Value *Store::_getKey(
-        std::unordered_map<std::string, std::unique_ptr<Value>> &values,
-        const char *name
-    ) {
-        if( values.find( name ) == values.end() ) return nullptr;
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_incBytes( unsigned long int bytes ) {
+        _bytes.fetch_add( bytes, std::memory_order_relaxed );
+    }
 
-        auto key = values[name].get();
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_decBytes( unsigned long int bytes ) {
+        _bytes.fetch_sub( bytes, std::memory_order_relaxed );
+    }
 
-        if( checkActualTs( key->tsEnd ) ) return key;
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_incValueBytes( Value *val ) {
+        auto lengthLogical = val->payload != nullptr && val->payload->getLengthOriginal() != 0
+            ? val->payload->getLengthOriginal()
+            : val->length;
 
-        return nullptr;
-    }
+        auto lengthShared = val->isPooled ? val->length : 0;
 
-    bool Store::incLimiter( Limiter *limiter, unsigned short int limit ) {
-        if( limit == 0 ) {
-            return true;
+        if( val->isPooled ) {
+            _pool.reference( val->payload );
         }
 
-#if MEMSESS_MULTI
-        std::lock_guard<std::mutex> lock( limiter->m );
-#endif
-        if( limiter->values.find( limit ) == limiter->values.end() ) {
-            LimiterValue value;
-            value.count = 1;
-            value.ts = getTime();
-            limiter->values[limit] = value;
+        _incBytes( _getSizeValue( val ) );
+        _bytesStored.fetch_add( val->length, std::memory_order_relaxed );
+        _bytesLogical.fetch_add( lengthLogical, std::memory_order_relaxed );
+        _bytesShared.fetch_add( lengthShared, std::memory_order_relaxed );
+    }
 
-            return true;
-        }
+    template<typename Policy, typename Monitoring>
+    unsigned long int Store<Policy, Monitoring>::_decValueBytes( Value *val ) {
+        auto bytes = _getSizeValue( val );
+        auto lengthLogical = val->payload != nullptr && val->payload->getLengthOriginal() != 0
+            ? val->payload->getLengthOriginal()
+            : val->length;
 
-        auto value = &limiter->values[limit];
+        auto lengthShared = val->isPooled ? val->length : 0;
 
+        if( val->isPooled ) {
+            _pool.unreference( val->payload );
+        }
 
-        if( limit == value->count && value->ts == getTime() ) {
+        _decBytes( bytes );
+        _bytesStored.fetch_sub( val->length, std::memory_order_relaxed );
+        _bytesLogical.fetch_sub( lengthLogical, std::memory_order_relaxed );
+        _bytesShared.fetch_sub( lengthShared, std::memory_order_relaxed );
+
+        return bytes;
+    }
+
+    template<typename Policy, typename Monitoring>
+    bool Store<Policy, Monitoring>::_isOverMemory() {
+        return _memory != 0 && _bytes + _pool.getBytes() > _memory;
+    }
+
+    template<typename Policy, typename Monitoring>
+    unsigned long int Store<Policy, Monitoring>::_random() {
+        static thread_local std::random_device rd;
+        static thread_local std::mt19937_64 gen( ( ( unsigned long int )rd() << 32 ) | rd() );
+
+        return gen();
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_touch( Item *sess ) {
+        auto msCur = getTime();
+
+        if( sess->tsAccess.load( std::memory_order_relaxed ) != msCur ) {
+            sess->tsAccess.store( msCur, std::memory_order_relaxed );
+        }
+
+        if( _eviction != EVICTION_LFU ) {
+            return;
+        }
+
+        auto frequency = _getFrequency( sess, msCur );
+        auto base = frequency > FREQUENCY_INIT ? frequency - FREQUENCY_INIT : 0;
+
+        if( frequency < FREQUENCY_MAX && _random() % ( base * FREQUENCY_FACTOR + 1 ) == 0 ) {
+            frequency++;
+        }
+
+        if( sess->frequency.load( std::memory_order_relaxed ) != frequency ) {
+            sess->frequency.store( frequency, std::memory_order_relaxed );
+        }
+    }
+
+    template<typename Policy, typename Monitoring>
+    unsigned int Store<Policy, Monitoring>::_getFrequency( Item *sess, unsigned long int msCur ) {
+        unsigned int frequency = sess->frequency.load( std::memory_order_relaxed );
+        unsigned long int tsAccess = sess->tsAccess.load( std::memory_order_relaxed );
+        auto periods = msCur > tsAccess ? ( msCur - tsAccess ) / DURATION_FREQUENCY_DECAY_MS : 0;
+
+        return periods >= frequency ? 0 : frequency - periods;
+    }
+
+    template<typename Policy, typename Monitoring>
+    bool Store<Policy, Monitoring>::_isBetterEviction( Item *sess, Item *other, unsigned long int msCur ) {
+        if( _eviction == EVICTION_LFU ) {
+            auto frequency = _getFrequency( sess, msCur );
+            auto frequencyOther = _getFrequency( other, msCur );
+
+            if( frequency != frequencyOther ) {
+                return frequency < frequencyOther;
+            }
+        } else if( _eviction == EVICTION_TTL ) {
+            auto tsEnd = sess->tsEnd == 0 ? ~0UL : sess->tsEnd;
+            auto tsEndOther = other->tsEnd == 0 ? ~0UL : other->tsEnd;
+
+            if( tsEnd != tsEndOther ) {
+                return tsEnd < tsEndOther;
+            }
+        }
+
+        return sess->tsAccess < other->tsAccess;
+    }
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Item *Store<Policy, Monitoring>::_sampleEviction( Shard *&shard ) {
+        auto msCur = getTime();
+        Item *victim = nullptr;
+
+        for( unsigned int i = 0; i < COUNT_EVICT_SAMPLES; i++ ) {
+            auto shardSample = &_shards[_random() % _countShards];
+            auto sess = shardSample->list.sample( _random(), COUNT_EVICT_PROBE );
+
+            if( sess != nullptr && ( victim == nullptr || _isBetterEviction( sess, victim, msCur ) ) ) {
+                victim = sess;
+                shard = shardSample;
+            }
+        }
+
+        return victim;
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_reclaim() {
+        for( unsigned int i = 0; i < COUNT_EVICT_BATCH && _isOverMemory(); i++ ) {
+            util::Epoch::Guard guard;
+            Shard *shard;
+
+            auto sess = _sampleEviction( shard );
+
+            if( sess == nullptr ) {
+                continue;
+            }
+
+            std::lock_guard<Lock> lockList( shard->m );
+
+            if( shard->list.find( sess->id ) != sess ) {
+                continue;
+            }
+
+            shard->list.erase( sess->id );
+            _monitoring->incEvictions( _deleteSession( shard, sess ) );
+            _decCount( shard );
+        }
+    }
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Item *Store<Policy, Monitoring>::_getSession( Shard *shard, const util::SessionId &sessionId ) {
+        auto sess = shard->list.find( sessionId );
+
+        if( sess == nullptr || !checkActualTs( sess->tsEnd ) ) {
+            return nullptr;
+        }
+
+        if( _memory != 0 || _logIdle != 0 ) {
+            _touch( sess );
+        }
+
+        return sess;
+    }
+
+    template<typename Policy, typename Monitoring>
+    unsigned int Store<Policy, Monitoring>::_getIndexShard( Shard *shard ) {
+        return shard - _shards.get();
+    }
+
+    template<typename Policy, typename Monitoring>
+    bool Store<Policy, Monitoring>::_incCount() {
+        auto count = _count.load();
+
+        do {
+            if( ( count >= _limit && _limit != 0 ) || count == 0xFF'FF'FF'FF ) {
+                return false;
+            }
+        } while( !_count.compare_exchange_weak( count, count + 1 ) );
+
+        return true;
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_decCount( Shard *shard ) {
+        _count--;
+        shard->count--;
+        _monitoring->updateTotalFreeSessions( _limit - _count );
+        _monitoring->updateShardSessions( _getIndexShard( shard ), shard->count );
+    }
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Result Store<Policy, Monitoring>::add( const util::SessionId &sessionId, unsigned long int lifetime ) {
+        _reclaim();
+
+        auto shard = _getShard( sessionId );
+
+        std::lock_guard<Lock> lockList( shard->m );
+        auto sess = shard->list.find( sessionId );
+
+        if( sess != nullptr && checkActualTs( sess->tsEnd ) ) {
+            return Result::E_DUPLICATE_SESSION;
+        }
+
+        if( sess == nullptr && !_incCount() ) {
+            _expire( shard, getTime(), COUNT_EXPIRE_BATCH );
+
+            if( !_incCount() ) {
+                return Result::E_LIMIT_EXCEEDED;
+            }
+        }
+
+        auto item = _createSession( shard, sessionId );
+
+        if( lifetime != 0 ) {
+            item->tsEnd = getTime() + lifetime;
+            _addExpiration( shard, sessionId, KEY_ID_NONE, item->tsEnd );
+        }
+
+        if( sess != nullptr ) {
+            shard->list.erase( sessionId );
+            shard->list.insert( item );
+            _deleteSession( shard, sess );
+
+            return Result::OK;
+        }
+
+        shard->list.insert( item );
+        shard->count++;
+        _monitoring->updateTotalFreeSessions( _limit - _count );
+        _monitoring->updateShardSessions( _getIndexShard( shard ), shard->count );
+
+        return Result::OK;
+    }
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Result Store<Policy, Monitoring>::generate( unsigned long int lifetime, util::SessionId &sessionId ) {
+        _reclaim();
+
+        while( true ) {
+            sessionId = util::SessionId::generate();
+            auto shard = _getShard( sessionId );
+
+            std::lock_guard<Lock> lockList( shard->m );
+
+            if( shard->list.find( sessionId ) != nullptr ) {
+                continue;
+            }
+
+            if( !_incCount() ) {
+                _expire( shard, getTime(), COUNT_EXPIRE_BATCH );
+
+                if( !_incCount() ) {
+                    return Result::E_LIMIT_EXCEEDED;
+                }
+            }
+
+            auto item = _createSession( shard, sessionId );
+
+            if( lifetime != 0 ) {
+                item->tsEnd = getTime() + lifetime;
+                _addExpiration( shard, sessionId, KEY_ID_NONE, item->tsEnd );
+            }
+
+            shard->list.insert( item );
+            shard->count++;
+            _monitoring->updateShardSessions( _getIndexShard( shard ), shard->count );
+            break;
+        }
+
+        _monitoring->updateTotalFreeSessions( _limit - _count );
+
+        return Result::OK;
+    }
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Result Store<Policy, Monitoring>::exist( const util::SessionId &sessionId ) {
+        auto shard = _getShard( sessionId );
+        util::Epoch::Guard guard;
+
+        if( _getSession( shard, sessionId ) != nullptr ) {
+            return Result::OK;
+        }
+
+        return Result::E_SESSION_NONE;
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::setLimit( unsigned int limit ) {
+        if( limit == 0 ) {
+            _count = 0;
+        }
+
+        _limit = limit;
+        _monitoring->updateTotalFreeSessions( _limit - _count );
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::setLimitKeys( unsigned int limit ) {
+        _symbols.setLimit( limit );
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::setMemory( unsigned long int memory, Eviction eviction ) {
+        _memory = memory;
+        _eviction = eviction;
+        _monitoring->setMemoryLimit( _memory );
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::setCompression( unsigned int threshold ) {
+        _compression = threshold;
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::setDeduplication( unsigned int threshold ) {
+        _deduplication = threshold;
+    }
+
+    template<typename Policy, typename Monitoring>
+    bool Store<Policy, Monitoring>::setLog( const std::string &path, unsigned int threshold, unsigned long int idle ) {
+        if( !_log.open( path ) ) {
             return false;
-        } else if( value->ts != getTime() ) {
-            value->ts = getTime();
-            value->count = 1;
+        }
+
+        _logThreshold = threshold;
+        _logIdle = idle;
+
+        return true;
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::setMaintenance( unsigned int countThreads ) {
+        if constexpr( Policy::IS_MULTI ) {
+            _executor.start( countThreads );
+        }
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::reserve( unsigned long int count ) {
+        auto countPerShard = count / _countShards + 1;
+
+        for( unsigned int i = 0; i < _countShards; i++ ) {
+            _shards[i].list.reserve( countPerShard + countPerShard / 8 );
+        }
+    }
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::KeyId Store<Policy, Monitoring>::getKeyId( std::string_view key, bool isCreate ) {
+        return isCreate ? _symbols.intern( key ) : _symbols.find( key );
+    }
+
+    template<typename Policy, typename Monitoring>
+    std::string_view Store<Policy, Monitoring>::getKeyName( KeyId key ) {
+        return _symbols.getName( key );
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::remove( const util::SessionId &sessionId ) {
+        auto shard = _getShard( sessionId );
+
+        std::lock_guard<Lock> lockList( shard->m );
+
+        auto sess = shard->list.erase( sessionId );
+
+        if( sess == nullptr ) {
+            return;
+        }
+
+        _deleteSession( shard, sess );
+        _decCount( shard );
+    }
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Result Store<Policy, Monitoring>::prolong( const util::SessionId &sessionId, unsigned long int lifetime ) {
+        auto shard = _getShard( sessionId );
+
+        std::shared_lock<Lock> lockList( shard->m );
+
+        auto sess = _getSession( shard, sessionId );
+
+        if( sess == nullptr ) {
+            return Result::E_SESSION_NONE;
+        }
+
+        std::lock_guard<Lock> lockValues( _getLock( sess ) );
+
+        if( lifetime != 0 ) {
+            sess->tsEnd = getTime() + lifetime;
+            _addExpiration( shard, sessionId, KEY_ID_NONE, sess->tsEnd );
+        } else {
+            sess->tsEnd = ~0UL;
+        }
+
+        return Result::OK;
+    }
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Result Store<Policy, Monitoring>::addKey(
+        const util::SessionId &sessionId,
+        KeyId key,
+        const char *value,
+        unsigned int length,
+        unsigned int &counterKeys,
+        unsigned int &counterRecord,
+        unsigned long int lifetime
+    ) {
+        if( key == KEY_ID_NONE ) {
+            return Result::E_LIMIT_EXCEEDED;
+        }
+
+        _reclaim();
+
+        auto tsEndKey = getTime() + lifetime;
+
+        auto shard = _getShard( sessionId );
+        util::Epoch::Guard guard;
+
+        std::shared_lock<Lock> lockList( shard->m );
+
+        auto sess = _getSession( shard, sessionId );
+
+        if( sess == nullptr ) {
+            return Result::E_SESSION_NONE;
+        }
+
+        if( !checkChildTs( sess->tsEnd, lifetime ) ) {
+            return Result::E_LIFETIME_EXCEEDED;
+        }
+
+        std::lock_guard<Lock> lockValues( _getLock( sess ) );
+
+        if( _getKey( sess, key ) != nullptr ) {
+            return Result::E_DUPLICATE_KEY;
+        }
+
+        sess->counterKeys++;
+
+        auto val = _createValue( shard, key, value, length );
+
+        if( lifetime != 0 ) {
+            val->tsEnd = tsEndKey;
+            _addExpiration( shard, sessionId, key, tsEndKey );
+        }
+
+        counterKeys = sess->counterKeys;
+        counterRecord = 0;
+
+        auto valOld = sess->values.erase( key );
+
+        if( valOld != nullptr ) {
+            _deleteValue( shard, valOld );
+        }
+
+        _insertValue( sess, val );
+
+        return Result::OK;
+    }
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Result Store<Policy, Monitoring>::existKey( const util::SessionId &sessionId, KeyId key ) {
+        auto shard = _getShard( sessionId );
+        util::Epoch::Guard guard;
+
+        auto sess = _getSession( shard, sessionId );
+
+        if( sess == nullptr ) {
+            return Result::E_SESSION_NONE;
+        }
+
+        if( _getKey( sess, key ) == nullptr ) {
+            return Result::E_KEY_NONE;
+        }
+
+        return Result::OK;
+    }
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Result Store<Policy, Monitoring>::prolongKey( const util::SessionId &sessionId, KeyId key, unsigned long int lifetime ) {
+        auto tsEndKey = getTime() + lifetime;
+
+        auto shard = _getShard( sessionId );
+        util::Epoch::Guard guard;
+
+        std::shared_lock<Lock> lockList( shard->m );
+
+        auto sess = _getSession( shard, sessionId );
+
+        if( sess == nullptr ) {
+            return Result::E_SESSION_NONE;
+        }
+
+        if( !checkChildTs( sess->tsEnd, lifetime ) ) {
+            return Result::E_LIFETIME_EXCEEDED;
+        }
+
+        _materialize( shard, sess, key );
+
+        std::shared_lock<Lock> lockValues( _getLock( sess ) );
+        auto val = _getKey( sess, key );
+
+        if( val == nullptr || val->isGlobal ) {
+            return Result::E_KEY_NONE;
+        }
+
+        std::lock_guard<Lock> lockValue( _getLock( val ) );
+
+        if ( lifetime != 0 ) {
+            val->tsEnd = tsEndKey;
+            _addExpiration( shard, sessionId, key, tsEndKey );
+        } else {
+            val->tsEnd = 0;
+        }
+
+        return Result::OK;
+    }
+
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Result Store<Policy, Monitoring>::setKey(
+        const util::SessionId &sessionId,
+        KeyId key,
+        const char *value,
+        unsigned int length,
+        unsigned int counterKeys,
+        unsigned int counterRecord,
+        unsigned short int limit
+    ) {
+        _reclaim();
+
+        auto shard = _getShard( sessionId );
+        util::Epoch::Guard guard;
+
+        std::shared_lock<Lock> lockList( shard->m );
+
+        auto sess = _getSession( shard, sessionId );
+
+        if( sess == nullptr ) {
+            return Result::E_SESSION_NONE;
+        }
+
+        _materialize( shard, sess, key );
+
+        std::shared_lock<Lock> lockValues( _getLock( sess ) );
+
+        auto val = _getKey( sess, key );
+
+        if( val == nullptr || val->isGlobal ) {
+            return Result::E_KEY_NONE;
+        }
+        
+        std::lock_guard<Lock> lockValue( _getLock( val ) );
+
+        if( val->counterRecord != counterRecord || sess->counterKeys != counterKeys ) {
+            return Result::E_RECORD_BEEN_CHANGED;
+        }
+
+        if( !val->limiterWrite.take( limit, getTime() ) ) {
+            return Result::E_LIMIT_PER_SEC_EXCEEDED;
+        }
+
+        _setValue( shard, val, value, length );
+
+        return Result::OK;
+    }
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Result Store<Policy, Monitoring>::setForceKey(
+        const util::SessionId &sessionId,
+        KeyId key,
+        const char *value,
+        unsigned int length,
+        unsigned short int limit
+    ) {
+        _reclaim();
+
+        auto shard = _getShard( sessionId );
+        util::Epoch::Guard guard;
+
+        std::shared_lock<Lock> lockList( shard->m );
+
+        auto sess = _getSession( shard, sessionId );
+
+        if( sess == nullptr ) {
+            return Result::E_SESSION_NONE;
+        }
+
+        _materialize( shard, sess, key );
+
+        std::shared_lock<Lock> lockValues( _getLock( sess ) );
+
+        auto val = _getKey( sess, key );
+
+        if( val == nullptr || val->isGlobal ) {
+            return Result::E_KEY_NONE;
+        }
+
+        std::lock_guard<Lock> lockValue( _getLock( val ) );
+
+        if( !val->limiterWrite.take( limit, getTime() ) ) {
+            return Result::E_LIMIT_PER_SEC_EXCEEDED;
+        }
+
+        _setValue( shard, val, value, length );
+
+        return Result::OK;
+    }
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Result Store<Policy, Monitoring>::getKey(
+        const util::SessionId &sessionId,
+        KeyId key,
+        util::PayloadRef &value,
+        unsigned int &counterKeys,
+        unsigned int &counterRecord,
+        unsigned short int limit,
+        bool isCompressed
+    ) {
+        auto shard = _getShard( sessionId );
+        util::Epoch::Guard guard;
+
+        auto sess = _getSession( shard, sessionId );
+
+        if( sess == nullptr ) {
+            return Result::E_SESSION_NONE;
+        }
+
+        auto val = _getKey( sess, key );
+
+        if( val != nullptr && val->isGlobal && limit != 0 ) {
+            std::shared_lock<Lock> lockList( shard->m );
+
+            if( _getSession( shard, sessionId ) != sess ) {
+                return Result::E_SESSION_NONE;
+            }
+
+            val = _materialize( shard, sess, key );
+        }
+
+        if( val == nullptr ) {
+            return Result::E_KEY_NONE;
+        }
+
+        if( !val->limiterRead.take( limit, getTime() ) ) {
+            return Result::E_LIMIT_PER_SEC_EXCEEDED;
+        }
+
+        _readValue( val, value, counterRecord );
+        counterKeys = sess->counterKeys;
+
+        if( !isCompressed && value.getLengthOriginal() != 0 ) {
+            _decompress( value );
+        }
+
+        return Result::OK;
+    }
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Result Store<Policy, Monitoring>::removeKey( const util::SessionId &sessionId, KeyId key ) {
+        auto shard = _getShard( sessionId );
+        util::Epoch::Guard guard;
+
+        std::shared_lock<Lock> lockList( shard->m );
+
+        auto sess = _getSession( shard, sessionId );
+
+        if( sess == nullptr ) {
+            return Result::E_SESSION_NONE;
+        }
+
+        std::lock_guard<Lock> lockValues( _getLock( sess ) );
+
+        auto val = sess->values.erase( key );
+
+        if( val != nullptr ) {
+            _deleteValue( shard, val );
+        }
+
+        if( _getKey( sess, key ) != nullptr ) {
+            auto tombstone = _createValue( shard, key, "", 0 );
+
+            tombstone->isRemoved = true;
+            _insertValue( sess, tombstone );
+        }
+
+        return Result::OK;
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::clearInactive() {
+        if( _countSweep != 0 ) {
+            _monitoring->updateQueueMaintenance( _executor.getDepth() );
+            return;
+        }
+
+        auto countChunks = ( _countShards + COUNT_SWEEP_SHARDS - 1 ) / COUNT_SWEEP_SHARDS;
+
+        _countSweep = countChunks + 1;
+        _tsSweep = util::Time::getMs();
+
+        for( unsigned int i = 0; i < countChunks; i++ ) {
+            _executor.submit( [this, i] { _sweep( i ); } );
+        }
+
+        _monitoring->updateQueueMaintenance( _executor.getDepth() );
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_sweep( unsigned int index ) {
+        util::Clock::update();
+
+        auto tsCur = getTime();
+        auto end = ( index + 1 ) * COUNT_SWEEP_SHARDS;
+
+        for( unsigned int i = index * COUNT_SWEEP_SHARDS; i < end && i < _countShards; i++ ) {
+            auto tStart = util::Time::getMs();
+
+            while( _clearInactive( &_shards[i], tsCur ) ) {
+                if( util::Time::getMs() - tStart >= DURATION_EXPIRE_MS ) {
+                    break;
+                }
+
+                if constexpr( Policy::IS_MULTI ) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        if( --_countSweep == 1 ) {
+            _finishSweep();
+            _countSweep = 0;
+        }
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_finishSweep() {
+        _reclaim();
+        _tier();
+        _purge();
+        _compact();
+        util::Epoch::collect();
+
+        if( _isTrim ) {
+#if defined( __GLIBC__ )
+            malloc_trim( 0 );
+#endif
+            _isTrim = false;
+        }
+
+        _updateMonitoringMemory();
+        _monitoring->updateDurationMaintenance( util::Time::getMs() - _tsSweep );
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_compact() {
+        auto shard = &_shards[_indexShardCompact];
+        unsigned long int bytes = 0;
+
+        _indexShardCompact = ( _indexShardCompact + 1 ) % _countShards;
+
+        {
+            std::lock_guard<Lock> lockList( shard->m );
+            bytes = shard->list.shrink();
+        }
+
+        if( bytes != 0 ) {
+            _isTrim = true;
+        }
+
+        bytes += shard->slab.trim();
+
+        if( bytes != 0 ) {
+            _monitoring->incReclaimed( bytes );
+        }
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_tier() {
+        if( !_log.isOpen() ) {
+            return;
+        }
+
+        auto msCur = getTime();
+        unsigned long int count = 0;
+
+        for( unsigned int i = 0; i < _countShards && count < COUNT_TIER_BATCH; i++ ) {
+            auto shard = &_shards[_indexShardTier];
+
+            _log.prepare();
+
+            std::shared_lock<Lock> lockList( shard->m );
+
+            auto capacity = shard->list.capacity();
+
+            for( ; _indexItemTier < capacity && count < COUNT_TIER_BATCH; _indexItemTier++, count++ ) {
+                if( !shard->list.isFull( _indexItemTier ) ) {
+                    continue;
+                }
+
+                auto sess = shard->list.getValue( _indexItemTier );
+                auto isIdle = _logIdle != 0 && msCur > sess->tsAccess + _logIdle;
+
+                std::shared_lock<Lock> lockValues( _getLock( sess ) );
+
+                for( unsigned long int j = 0; j < sess->values.capacity(); j++ ) {
+                    if( !sess->values.isFull( j ) ) {
+                        continue;
+                    }
+
+                    auto val = sess->values.getValue( j );
+
+                    if( val->payload == nullptr || val->isPooled ) {
+                        continue;
+                    }
+
+                    if( val->isLogged ? _log.isSparse( val->payload ) : isIdle ) {
+                        _spill( val, isIdle );
+                    }
+                }
+            }
+
+            if( _indexItemTier < capacity ) {
+                break;
+            }
+
+            _indexItemTier = 0;
+            _indexShardTier = ( _indexShardTier + 1 ) % _countShards;
+        }
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_spill( Value *val, bool isIdle ) {
+        std::lock_guard<Lock> lockValue( _getLock( val ) );
+
+        if( val->payload == nullptr || val->isPooled ) {
+            return;
+        }
+
+        if( val->isLogged ? !_log.isSparse( val->payload ) : !isIdle ) {
+            return;
+        }
+
+        auto payloadOld = val->payload;
+        auto payload = _log.append( val->data, val->length, payloadOld->getLengthOriginal(), false );
+
+        if( payload == nullptr ) {
+            return;
+        }
+
+        _decValueBytes( val );
+
+        val->seq++;
+        val->payload = payload;
+        val->data = payload->getData();
+        val->isLogged = true;
+        val->seq++;
+
+        _incValueBytes( val );
+        payloadOld->release();
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_purge() {
+        if( _generationPass == 0 ) {
+            if( _generationPurge == _generationPurged ) {
+                return;
+            }
+
+            _generationPass = _generationPurge;
+        }
+
+        util::Epoch::Guard guard;
+        unsigned long int count = 0;
+
+        while( _indexShardPurge < _countShards && count < COUNT_PURGE_BATCH ) {
+            auto shard = &_shards[_indexShardPurge];
+
+            std::shared_lock<Lock> lockList( shard->m );
+
+            _sessionsPurge.clear();
+            _positionPurge = shard->list.scan( _positionPurge, COUNT_PURGE_BATCH - count, _sessionsPurge );
+            count += _sessionsPurge.size() + 1;
+
+            for( auto sess : _sessionsPurge ) {
+                std::lock_guard<Lock> lockValues( _getLock( sess ) );
+                _purgeValues( shard, sess );
+            }
+
+            if( _positionPurge == 0 ) {
+                _indexShardPurge++;
+            }
+        }
+
+        if( _indexShardPurge < _countShards ) {
+            return;
+        }
+
+        _indexShardPurge = 0;
+        _generationPurged = _generationPass;
+        _generationPass = 0;
+        _purgeGlobals( _generationPurged );
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_purgeValues( Shard *shard, Item *sess ) {
+        _keysPurge.clear();
+
+        for( unsigned long int i = 0; i < sess->values.capacity(); i++ ) {
+            if( !sess->values.isFull( i ) ) {
+                continue;
+            }
+
+            auto val = sess->values.getValue( i );
+            auto global = _globals.find( val->key );
+
+            if( global != nullptr && val->generation < global->generationRemoved.load( std::memory_order_acquire ) ) {
+                _keysPurge.push_back( val->key );
+            }
+        }
+
+        for( auto key : _keysPurge ) {
+            _deleteValue( shard, sess->values.erase( key ) );
+        }
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_purgeGlobals( unsigned long int generation ) {
+        std::lock_guard<Lock> lockGlobals( _mGlobals );
+
+        _keysPurge.clear();
+
+        for( unsigned long int i = 0; i < _globals.capacity(); i++ ) {
+            if( !_globals.isFull( i ) ) {
+                continue;
+            }
+
+            auto global = _globals.getValue( i );
+
+            if( global->head.load( std::memory_order_relaxed ) == nullptr && global->generationRemoved <= generation ) {
+                _keysPurge.push_back( global->key );
+            }
+        }
+
+        for( auto key : _keysPurge ) {
+            util::Epoch::retire( _freeGlobal, nullptr, _globals.erase( key ) );
+        }
+    }
+
+    template<typename Policy, typename Monitoring>
+    bool Store<Policy, Monitoring>::_clearInactive( Shard *shard, unsigned long int tsCur ) {
+        std::lock_guard<Lock> lockList( shard->m );
+
+        return _expire( shard, tsCur, COUNT_EXPIRE_BATCH );
+    }
+
+    template<typename Policy, typename Monitoring>
+    bool Store<Policy, Monitoring>::_expire( Shard *shard, unsigned long int tsCur, unsigned int limit ) {
+        Expiration expiration;
+
+        for( unsigned int i = 0; i < limit; i++ ) {
+            {
+                std::lock_guard<Mutex> lock( shard->mExpirations );
+                if( !shard->expirations.pop( tsCur / DURATION_WHEEL_TICK_MS, expiration ) ) {
+                    return false;
+                }
+            }
+
+            auto sess = shard->list.find( expiration.sessionId );
+
+            if( sess == nullptr ) {
+                continue;
+            }
+
+            if( !expiration.isKey ) {
+                if( sess->tsEnd != 0 && sess->tsEnd < tsCur ) {
+                    shard->list.erase( expiration.sessionId );
+                    _deleteSession( shard, sess );
+                    _decCount( shard );
+                }
+
+                continue;
+            }
+
+            auto val = sess->values.find( expiration.key );
+
+            if( val != nullptr && val->tsEnd != 0 && val->tsEnd < tsCur ) {
+                sess->values.erase( expiration.key );
+                _deleteValue( shard, val );
+            }
+        }
+
+        return true;
+    }
+
+    template<typename Policy, typename Monitoring>
+    void Store<Policy, Monitoring>::_addExpiration(
+        Shard *shard,
+        const util::SessionId &sessionId,
+        KeyId key,
+        unsigned long int tsEnd
+    ) {
+        std::lock_guard<Mutex> lock( shard->mExpirations );
+
+        if( key == KEY_ID_NONE ) {
+            shard->expirations.add( tsEnd / DURATION_WHEEL_TICK_MS + 1, Expiration{ sessionId, false, key } );
         } else {
-            value->count++;
+            shard->expirations.add( tsEnd / DURATION_WHEEL_TICK_MS + 1, Expiration{ sessionId, true, key } );
+        }
+    }
+
+    template<typename Policy, typename Monitoring>
+    bool Store<Policy, Monitoring>::checkActualTs( unsigned long int ts ) {
+        return ts == 0 || ts >= getTime();
+    }
+
+    template<typename Policy, typename Monitoring>
+    bool Store<Policy, Monitoring>::checkChildTs( unsigned long int parentTs, unsigned long int keyLifetime ) {
+        auto tsEndKey = getTime() + keyLifetime;
+
+        if( keyLifetime != 0 && parentTs != 0 && parentTs < tsEndKey ) {
+            return false;
         }
 
         return true;
     }
 
-    Store::Result Store::addAllKey(
-        const char *key,
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Value *Store<Policy, Monitoring>::_getKey( Item *sess, KeyId id ) {
+        auto key = sess->values.find( id );
+        auto global = _globals.find( id );
+
+        if( global == nullptr ) {
+            if( key != nullptr && !key->isRemoved && checkActualTs( key->tsEnd ) ) return key;
+
+            return nullptr;
+        }
+
+        if( key != nullptr && key->generation < global->generationRemoved.load( std::memory_order_acquire ) ) {
+            key = nullptr;
+        }
+
+        if( key != nullptr && !key->isRemoved ) {
+            return checkActualTs( key->tsEnd ) ? key : nullptr;
+        }
+
+        auto generation = key != nullptr ? key->generation : sess->generation;
+        Value *result = nullptr;
+
+        if( generation < sess->generation ) {
+            generation = sess->generation;
+        }
+
+        for( auto val = global->head.load( std::memory_order_acquire ); val != nullptr; val = val->next ) {
+            if( val->generation <= generation ) {
+                break;
+            }
+
+            result = val;
+        }
+
+        return result;
+    }
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Result Store<Policy, Monitoring>::addAllKey(
+        KeyId key,
         const char *value,
         unsigned int length
     ) {
-#if MEMSESS_MULTI
-        util::LockAtomic lock( _writers );
-        std::lock_guard<std::shared_timed_mutex> lockList( _m );
-#endif
-        auto tsCur = getTime();
+        if( key == KEY_ID_NONE ) {
+            return Result::E_LIMIT_EXCEEDED;
+        }
 
-        for( auto it = _list.begin(); it != _list.end(); ++it ) {
-            auto sess = _list[it->first].get();
+        _reclaim();
 
-            if( sess->tsEnd < tsCur || sess->values.find( key ) != sess->values.end() ) {
-                continue;
-            }
+        auto val = new Value();
+
+        val->key = key;
+        val->isGlobal = true;
+        _setData( nullptr, val, value, length );
+        _incValueBytes( val );
 
-            auto val = std::make_unique<Value>();
-            val->value = std::string( value, length );
+        std::lock_guard<Lock> lockGlobals( _mGlobals );
+        auto global = _getGlobal( key );
 
-            val->limiterWrite = std::make_unique<Limiter>();
-            val->limiterRead = std::make_unique<Limiter>();
+        val->generation = ++_generation;
+        val->next = global->head.load( std::memory_order_relaxed );
+        global->head.store( val, std::memory_order_release );
+
+        return Result::OK;
+    }
 
-            sess->values[key] = std::move( val );
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Result Store<Policy, Monitoring>::removeAllKey( KeyId key ) {
+        if( key == KEY_ID_NONE ) {
+            return Result::OK;
         }
 
+        std::lock_guard<Lock> lockGlobals( _mGlobals );
+        auto global = _getGlobal( key );
+        auto generation = ++_generation;
+
+        global->generationRemoved.store( generation, std::memory_order_release );
+        _removeGlobalValues( global->head.exchange( nullptr, std::memory_order_acq_rel ) );
+        _generationPurge = generation;
+
         return Result::OK;
     }
 
-    Store::Result Store::removeAllKey( const char *key ) {
-#if MEMSESS_MULTI
-        util::LockAtomic lock( _writers );
-        std::lock_guard<std::shared_timed_mutex> lockList( _m );
-#endif
-        auto tsCur = getTime();
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Result Store<Policy, Monitoring>::setTag( const util::SessionId &sessionId, std::string_view tag ) {
+        auto shard = _getShard( sessionId );
 
-        for( auto it = _list.begin(); it != _list.end(); ++it ) {
-            auto sess = _list[it->first].get();
+        std::shared_lock<Lock> lockList( shard->m );
 
-            if( sess->tsEnd < tsCur ) {
-                continue;
-            }
+        auto sess = _getSession( shard, sessionId );
+
+        if( sess == nullptr ) {
+            return Result::E_SESSION_NONE;
+        }
+
+        std::lock_guard<Mutex> lockTags( _mTags );
+
+        if( sess->tag != nullptr && sess->tag->name == tag ) {
+            return Result::OK;
+        }
+
+        if( sess->tag != nullptr ) {
+            _untag( sess );
+        }
+
+        if( tag.empty() ) {
+            return Result::OK;
+        }
+
+        auto item = _tags.find( tag );
+
+        if( item == nullptr ) {
+            item = new Tag();
+            item->name = tag;
+            _tags.insert( item );
+        }
+
+        sess->tag = item;
+        sess->indexTag = item->sessions.size();
+        item->sessions.push_back( sess );
+
+        return Result::OK;
+    }
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Result Store<Policy, Monitoring>::removeByTag( std::string_view tag, unsigned int &count ) {
+        std::vector<util::SessionId> sessions;
+
+        _getTagged( tag, sessions );
+
+        for( auto &sessionId : sessions ) {
+            remove( sessionId );
+        }
+
+        count = sessions.size();
 
-            sess->values.erase( key );
+        return Result::OK;
+    }
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Result Store<Policy, Monitoring>::prolongByTag(
+        std::string_view tag,
+        unsigned long int lifetime,
+        unsigned int &count
+    ) {
+        std::vector<util::SessionId> sessions;
+
+        _getTagged( tag, sessions );
+        count = 0;
+
+        for( auto &sessionId : sessions ) {
+            if( prolong( sessionId, lifetime ) == Result::OK ) {
+                count++;
+            }
         }
 
         return Result::OK;
     }
+
+    template<typename Policy, typename Monitoring>
+    typename Store<Policy, Monitoring>::Result Store<Policy, Monitoring>::listByTag(
+        std::string_view tag,
+        std::vector<util::SessionId> &sessions
+    ) {
+        _getTagged( tag, sessions );
+
+        return Result::OK;
+    }
+
+    template<typename Policy, typename Monitoring>
+    unsigned long int Store<Policy, Monitoring>::scan(
+        unsigned long int cursor,
+        unsigned int count,
+        bool isKeys,
+        std::vector<ScanItem> &items
+    ) {
+        unsigned long int indexShard = cursor >> BITS_SCAN_POSITION;
+        unsigned long int position = cursor << ( 64 - BITS_SCAN_POSITION );
+        std::vector<Item *> sessions;
+        std::vector<KeyId> keysGlobal;
+        util::Epoch::Guard guard;
+        auto msCur = getTime();
+
+        items.clear();
+
+        if( isKeys ) {
+            std::shared_lock<Lock> lockGlobals( _mGlobals );
+
+            for( unsigned long int i = 0; i < _globals.capacity(); i++ ) {
+                if( _globals.isFull( i ) ) {
+                    keysGlobal.push_back( _globals.getKey( i ) );
+                }
+            }
+        }
+
+        while( indexShard < _countShards && items.size() < count ) {
+            auto shard = &_shards[indexShard];
+
+            std::shared_lock<Lock> lockList( shard->m );
+
+            sessions.clear();
+            position = shard->list.scan( position, count - items.size(), sessions );
+
+            for( auto sess : sessions ) {
+                if( !checkActualTs( sess->tsEnd ) ) {
+                    continue;
+                }
+
+                items.emplace_back();
+
+                auto &item = items.back();
+
+                item.id = sess->id;
+                item.ttl = sess->tsEnd == 0 || sess->tsEnd == ~0UL || sess->tsEnd <= msCur ? 0 : sess->tsEnd - msCur;
+
+                if( !isKeys ) {
+                    continue;
+                }
+
+                std::shared_lock<Lock> lockValues( _getLock( sess ) );
+
+                for( unsigned long int i = 0; i < sess->values.capacity(); i++ ) {
+                    if( !sess->values.isFull( i ) ) {
+                        continue;
+                    }
+
+                    auto key = sess->values.getValue( i )->key;
+
+                    if( _getKey( sess, key ) != nullptr ) {
+                        item.keys.push_back( key );
+                    }
+                }
+
+                for( auto key : keysGlobal ) {
+                    if( sess->values.find( key ) == nullptr && _getKey( sess, key ) != nullptr ) {
+                        item.keys.push_back( key );
+                    }
+                }
+            }
+
+            if( position == 0 ) {
+                indexShard++;
+            }
+        }
+
+        if( indexShard >= _countShards ) {
+            return 0;
+        }
+
+        return ( indexShard << BITS_SCAN_POSITION ) | ( position >> ( 64 - BITS_SCAN_POSITION ) );
+    }
 }
 
 #endif
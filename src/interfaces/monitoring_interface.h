@@ -2,6 +2,7 @@
 #define MEMSESS_I_MONITORING
 
 #include <string>
+#include <vector>
 
 namespace memsess::i {
     class MonitoringInterface {
@@ -54,6 +55,35 @@ namespace memsess::i {
                 unsigned long int disconnection;
             };
 
+            struct DataSlab {
+                unsigned long int size;
+                unsigned long int slabs;
+                unsigned long int bytesLive;
+                unsigned long int bytesWasted;
+            };
+            struct DataMemory {
+                unsigned long int limit;
+                unsigned long int bytes;
+                unsigned long int evictions;
+                unsigned long int bytesEvicted;
+                unsigned long int bytesStored;
+                unsigned long int bytesLogical;
+                unsigned long int bytesLocks;
+                unsigned long int bytesPooled;
+                unsigned long int bytesShared;
+                unsigned long int bytesReclaimed;
+                unsigned long int allocations;
+                unsigned long int bytesLog;
+                unsigned long int bytesLogLive;
+            };
+
+            struct DataMaintenance {
+                unsigned long int jobs;
+                unsigned long int duration;
+                unsigned long int durationMax;
+                unsigned long int queue;
+            };
+
             struct Data {
                 DataTraffic traffic;
                 DataMethods passedRequests;
@@ -63,6 +93,10 @@ namespace memsess::i {
                 DataDuration durationProcessing;
                 DataDuration durationSending;
                 unsigned long int totalFreeSessions;
+                std::vector<unsigned long int> shardSessions;
+                std::vector<DataSlab> slabs;
+                DataMemory memory;
+                DataMaintenance maintenance;
             };
 
             virtual void incSendedBytes( unsigned int ) = 0;
@@ -115,6 +149,20 @@ namespace memsess::i {
             virtual void updateDurationSending( unsigned int ) = 0;
 
             virtual void updateTotalFreeSessions( unsigned int ) = 0;
+            virtual void setCountShards( unsigned int ) = 0;
+            virtual void updateShardSessions( unsigned int, unsigned int ) = 0;
+            virtual void updateSlabs( const std::vector<DataSlab> & ) = 0;
+            virtual void setMemoryLimit( unsigned long int ) = 0;
+            virtual void updateMemory( unsigned long int ) = 0;
+            virtual void incEvictions( unsigned long int ) = 0;
+            virtual void updateValueBytes( unsigned long int, unsigned long int ) = 0;
+            virtual void setLockBytes( unsigned long int ) = 0;
+            virtual void updatePoolBytes( unsigned long int, unsigned long int ) = 0;
+            virtual void incReclaimed( unsigned long int ) = 0;
+            virtual void incAllocations( unsigned long int ) = 0;
+            virtual void updateLogBytes( unsigned long int, unsigned long int ) = 0;
+            virtual void updateDurationMaintenance( unsigned long int ) = 0;
+            virtual void updateQueueMaintenance( unsigned int ) = 0;
 
             virtual void getData( Data &data ) = 0;
 
@@ -1,15 +1,19 @@
 #ifndef MEMSESS_I_SERVER_CONTROLLER
 #define MEMSESS_I_SERVER_CONTROLLER
 
-#include <memory>
+#include "../util/payload.hpp"
+#include "../util/byte_buffer.hpp"
  
 namespace memsess::i {
     class ServerControllerInterface {
         public:
-            virtual std::unique_ptr<char[]> parse(
+            virtual void parse(
                 const char *data,
                 unsigned int length,
-                unsigned int &resultLength
+                util::ByteBuffer &result,
+                unsigned int &resultLength,
+                util::PayloadRef &payload,
+                unsigned int &payloadOffset
             ) = 0;
             virtual void interval() = 0;
     };
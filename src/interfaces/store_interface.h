@@ -2,6 +2,10 @@
 #define MEMSESS_I_STORE
 
 #include <string>
+#include <string_view>
+#include <vector>
+#include "../util/session_id.hpp"
+#include "../util/payload.hpp"
 
 namespace memsess::i {
     class StoreInterface {
@@ -17,32 +21,54 @@ namespace memsess::i {
                 E_RECORD_BEEN_CHANGED,
                 E_LIMIT_PER_SEC_EXCEEDED,
             };
+            typedef unsigned int KeyId;
+            static const KeyId KEY_ID_NONE = ~0U;
+            struct ScanItem {
+                util::SessionId id;
+                unsigned long int ttl;
+                std::vector<KeyId> keys;
+            };
+            enum Eviction {
+                EVICTION_LRU,
+                EVICTION_LFU,
+                EVICTION_TTL,
+            };
             virtual void setLimit( unsigned int limit ) = 0;
+            virtual void setLimitKeys( unsigned int limit ) = 0;
+            virtual void setMemory( unsigned long int memory, Eviction eviction = EVICTION_LRU ) = 0;
+            virtual void setCompression( unsigned int threshold ) = 0;
+            virtual void setDeduplication( unsigned int threshold ) = 0;
+            virtual bool setLog( const std::string &path, unsigned int threshold, unsigned long int idle ) = 0;
+            virtual void setMaintenance( unsigned int countThreads ) = 0;
+            virtual void reserve( unsigned long int count ) = 0;
+
+            virtual KeyId getKeyId( std::string_view key, bool isCreate = false ) = 0;
+            virtual std::string_view getKeyName( KeyId key ) = 0;
 
-            virtual Result add( const char *sessionId, unsigned int lifetime = 0 ) = 0;
-            virtual Result generate( unsigned int lifetime, char *sessionId ) = 0;
-            virtual Result exist( const char *sessionId ) = 0;
-            virtual void remove( const char *sessionId ) = 0;
-            virtual Result prolong( const char *sessionId, unsigned int lifetime ) = 0;
+            virtual Result add( const util::SessionId &sessionId, unsigned long int lifetime = 0 ) = 0;
+            virtual Result generate( unsigned long int lifetime, util::SessionId &sessionId ) = 0;
+            virtual Result exist( const util::SessionId &sessionId ) = 0;
+            virtual void remove( const util::SessionId &sessionId ) = 0;
+            virtual Result prolong( const util::SessionId &sessionId, unsigned long int lifetime ) = 0;
          
             virtual Result addKey(
-                const char *sessionId,
-                const char *key,
+                const util::SessionId &sessionId,
+                KeyId key,
                 const char *value,
                 unsigned int length,
                 unsigned int &counterKeys,
                 unsigned int &counterRecord,
-                unsigned int lifetime = 0
+                unsigned long int lifetime = 0
             ) = 0;
-            virtual Result existKey( const char *sessionId, const char *key ) = 0;
+            virtual Result existKey( const util::SessionId &sessionId, KeyId key ) = 0;
             virtual Result prolongKey(
-                const char *sessionId,
-                const char *key,
-                unsigned int lifetime
+                const util::SessionId &sessionId,
+                KeyId key,
+                unsigned long int lifetime
             ) = 0;
             virtual Result setKey(
-                const char *sessionId,
-                const char *key,
+                const util::SessionId &sessionId,
+                KeyId key,
                 const char *value,
                 unsigned int length,
                 unsigned int counterKeys,
@@ -50,29 +76,40 @@ namespace memsess::i {
                 unsigned short int limit = 0
             ) = 0;
             virtual Result setForceKey(
-                const char *sessionId,
-                const char *key,
+                const util::SessionId &sessionId,
+                KeyId key,
                 const char *value,
                 unsigned int length,
                 unsigned short int limit = 0
             ) = 0;
             virtual Result getKey(
-                const char *sessionId,
-                const char *key,
-                std::string &value,
+                const util::SessionId &sessionId,
+                KeyId key,
+                util::PayloadRef &value,
                 unsigned int &counterKeys,
                 unsigned int &counterRecord,
-                unsigned short int limit = 0
+                unsigned short int limit = 0,
+                bool isCompressed = false
             ) = 0;
-            virtual Result removeKey( const char *sessionId, const char *key ) = 0;
+            virtual Result removeKey( const util::SessionId &sessionId, KeyId key ) = 0;
          
             virtual void clearInactive() = 0;
             virtual Result addAllKey(
-                const char *key,
+                KeyId key,
                 const char *value,
                 unsigned int length
             ) = 0;
-            virtual Result removeAllKey( const char *key ) = 0;
+            virtual Result removeAllKey( KeyId key ) = 0;
+            virtual Result setTag( const util::SessionId &sessionId, std::string_view tag ) = 0;
+            virtual Result removeByTag( std::string_view tag, unsigned int &count ) = 0;
+            virtual Result prolongByTag( std::string_view tag, unsigned long int lifetime, unsigned int &count ) = 0;
+            virtual Result listByTag( std::string_view tag, std::vector<util::SessionId> &sessions ) = 0;
+            virtual unsigned long int scan(
+                unsigned long int cursor,
+                unsigned int count,
+                bool isKeys,
+                std::vector<ScanItem> &items
+            ) = 0;
     };
 }
 
@@ -0,0 +1,79 @@
+#ifndef MEMSESS_UTIL_ALLOCATIONS
+#define MEMSESS_UTIL_ALLOCATIONS
+
+#include <new>
+#include <stdlib.h>
+
+namespace memsess::util {
+    class Allocations {
+        private:
+            static thread_local unsigned long int _count;
+
+        public:
+            static void *malloc( std::size_t size );
+            static void *calloc( std::size_t count, std::size_t size );
+            static void *alignedAlloc( std::size_t alignment, std::size_t size );
+            static unsigned long int getCount();
+    };
+
+    inline thread_local unsigned long int Allocations::_count = 0;
+
+    void *Allocations::malloc( std::size_t size ) {
+#if MEMSESS_COUNT_ALLOCATIONS
+        _count++;
+#endif
+        return ::malloc( size );
+    }
+
+    void *Allocations::calloc( std::size_t count, std::size_t size ) {
+#if MEMSESS_COUNT_ALLOCATIONS
+        _count++;
+#endif
+        return ::calloc( count, size );
+    }
+
+    void *Allocations::alignedAlloc( std::size_t alignment, std::size_t size ) {
+#if MEMSESS_COUNT_ALLOCATIONS
+        _count++;
+#endif
+        return ::aligned_alloc( alignment, size );
+    }
+
+    unsigned long int Allocations::getCount() {
+        return _count;
+    }
+}
+
+#if MEMSESS_COUNT_ALLOCATIONS
+__attribute__(( noinline )) void *operator new( std::size_t size ) {
+    auto ptr = memsess::util::Allocations::malloc( size == 0 ? 1 : size );
+
+    if( ptr == nullptr ) {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+__attribute__(( noinline )) void *operator new[]( std::size_t size ) {
+    return operator new( size );
+}
+
+__attribute__(( noinline )) void operator delete( void *ptr ) noexcept {
+    free( ptr );
+}
+
+__attribute__(( noinline )) void operator delete[]( void *ptr ) noexcept {
+    free( ptr );
+}
+
+__attribute__(( noinline )) void operator delete( void *ptr, std::size_t ) noexcept {
+    free( ptr );
+}
+
+__attribute__(( noinline )) void operator delete[]( void *ptr, std::size_t ) noexcept {
+    free( ptr );
+}
+#endif
+
+#endif
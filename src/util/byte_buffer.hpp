@@ -0,0 +1,42 @@
+#ifndef MEMSESS_UTIL_BYTE_BUFFER
+#define MEMSESS_UTIL_BYTE_BUFFER
+
+#include <memory>
+
+namespace memsess::util {
+    class ByteBuffer {
+        public:
+            static const unsigned int SIZE_KEEP = 65'536;
+
+        private:
+            std::unique_ptr<char[]> _data;
+            unsigned int _capacity = 0;
+
+        public:
+            char *reserve( unsigned int length );
+            char *getData();
+            void shrink();
+    };
+
+    char *ByteBuffer::reserve( unsigned int length ) {
+        if( length > _capacity ) {
+            _data.reset( new char[length] );
+            _capacity = length;
+        }
+
+        return _data.get();
+    }
+
+    char *ByteBuffer::getData() {
+        return _data.get();
+    }
+
+    void ByteBuffer::shrink() {
+        if( _capacity > SIZE_KEEP ) {
+            _data.reset();
+            _capacity = 0;
+        }
+    }
+}
+
+#endif
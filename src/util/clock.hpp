@@ -0,0 +1,41 @@
+#ifndef MEMSESS_UTIL_CLOCK
+#define MEMSESS_UTIL_CLOCK
+
+#include <time.h>
+
+namespace memsess::util {
+    class Clock {
+        private:
+            static thread_local unsigned long int _ms;
+
+            static unsigned long int _read();
+
+        public:
+            static void update();
+            static unsigned long int getMs();
+    };
+
+    inline thread_local unsigned long int Clock::_ms = 0;
+
+    unsigned long int Clock::_read() {
+        timespec ts;
+
+        clock_gettime( CLOCK_MONOTONIC_COARSE, &ts );
+
+        return ts.tv_sec * 1'000UL + ts.tv_nsec / 1'000'000;
+    }
+
+    void Clock::update() {
+        _ms = _read();
+    }
+
+    unsigned long int Clock::getMs() {
+        if( _ms == 0 ) {
+            update();
+        }
+
+        return _ms;
+    }
+}
+
+#endif
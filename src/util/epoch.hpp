@@ -0,0 +1,167 @@
+#ifndef MEMSESS_UTIL_EPOCH
+#define MEMSESS_UTIL_EPOCH
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace memsess::util {
+    class Epoch {
+        public:
+            typedef void ( *Free )( void *ctx, void *ptr, unsigned int size );
+
+            class Guard {
+                public:
+                    Guard();
+                    ~Guard();
+            };
+
+        private:
+            static const unsigned int MAX_THREADS = 1'024;
+            static const unsigned int COUNT_RETIRED_COLLECT = 1'024;
+
+            struct alignas( 64 ) Slot {
+                std::atomic<unsigned long int> epoch{0};
+            };
+
+            struct Retired {
+                unsigned long int epoch;
+                Free free;
+                void *ctx;
+                void *ptr;
+                unsigned int size;
+            };
+
+            static bool _isShared;
+            static std::atomic<unsigned long int> _global;
+            static Slot _slots[MAX_THREADS];
+            static std::atomic<unsigned int> _countSlots;
+            static thread_local unsigned int _index;
+            static thread_local unsigned int _depth;
+            static std::mutex _m;
+            static std::vector<Retired> _retired;
+            static thread_local std::vector<Retired> _ready;
+            static thread_local bool _isFreeing;
+
+            static Slot *_getSlot();
+            static void _collect( std::vector<Retired> &ready );
+            static void _free( std::vector<Retired> &ready );
+
+        public:
+            static void setShared( bool isShared );
+            static void retire( Free free, void *ctx, void *ptr, unsigned int size = 0 );
+            static void collect();
+    };
+
+    inline bool Epoch::_isShared = true;
+    inline std::atomic<unsigned long int> Epoch::_global{1};
+    inline Epoch::Slot Epoch::_slots[Epoch::MAX_THREADS];
+    inline std::atomic<unsigned int> Epoch::_countSlots{0};
+    inline thread_local unsigned int Epoch::_index = Epoch::MAX_THREADS;
+    inline thread_local unsigned int Epoch::_depth = 0;
+    inline std::mutex Epoch::_m;
+    inline std::vector<Epoch::Retired> Epoch::_retired;
+    inline thread_local std::vector<Epoch::Retired> Epoch::_ready;
+    inline thread_local bool Epoch::_isFreeing = false;
+
+    Epoch::Slot *Epoch::_getSlot() {
+        if( _index == MAX_THREADS ) {
+            _index = _countSlots++;
+        }
+
+        return &_slots[_index];
+    }
+
+    void Epoch::setShared( bool isShared ) {
+        _isShared = isShared;
+    }
+
+    Epoch::Guard::Guard() {
+        if( _isShared && _depth++ == 0 ) {
+            _getSlot()->epoch.store( _global.load() );
+            std::atomic_thread_fence( std::memory_order_seq_cst );
+        }
+    }
+
+    Epoch::Guard::~Guard() {
+        if( _isShared && --_depth == 0 ) {
+            _getSlot()->epoch.store( 0, std::memory_order_release );
+        }
+    }
+
+    void Epoch::_collect( std::vector<Retired> &ready ) {
+        auto min = ~0UL;
+        unsigned int countSlots = _countSlots;
+
+        for( unsigned int i = 0; i < countSlots && i < MAX_THREADS; i++ ) {
+            auto epoch = _slots[i].epoch.load();
+
+            if( epoch != 0 && epoch < min ) {
+                min = epoch;
+            }
+        }
+
+        unsigned long int count = 0;
+
+        for( auto &retired : _retired ) {
+            if( retired.epoch < min ) {
+                ready.push_back( retired );
+            } else {
+                _retired[count++] = retired;
+            }
+        }
+
+        _retired.resize( count );
+    }
+
+    void Epoch::_free( std::vector<Retired> &ready ) {
+        auto isFreeing = _isFreeing;
+        _isFreeing = true;
+
+        for( auto &retired : ready ) {
+            retired.free( retired.ctx, retired.ptr, retired.size );
+        }
+
+        _isFreeing = isFreeing;
+    }
+
+    void Epoch::retire( Free free, void *ctx, void *ptr, unsigned int size ) {
+        if( !_isShared ) {
+            free( ctx, ptr, size );
+
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock( _m );
+
+            _retired.push_back( Retired{ _global.fetch_add( 1 ), free, ctx, ptr, size } );
+
+            if( _isFreeing || _retired.size() < COUNT_RETIRED_COLLECT ) {
+                return;
+            }
+
+            _collect( _ready );
+        }
+
+        _free( _ready );
+        _ready.clear();
+    }
+
+    void Epoch::collect() {
+        std::vector<Retired> ready;
+
+        do {
+            ready.clear();
+
+            {
+                std::lock_guard<std::mutex> lock( _m );
+                _collect( ready );
+            }
+
+            _free( ready );
+        } while( !ready.empty() );
+    }
+}
+
+#endif
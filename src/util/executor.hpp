@@ -0,0 +1,109 @@
+#ifndef MEMSESS_UTIL_EXECUTOR
+#define MEMSESS_UTIL_EXECUTOR
+
+#include <functional>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace memsess::util {
+    class Executor {
+        public:
+            typedef std::function<void()> Job;
+
+        private:
+            std::vector<std::thread> _threads;
+            std::deque<Job> _jobs;
+            std::mutex _m;
+            std::condition_variable _cv;
+            std::atomic<unsigned int> _depth{0};
+            bool _isStop = false;
+
+            void _work();
+
+        public:
+            Executor() = default;
+            ~Executor();
+            Executor( const Executor & ) = delete;
+            Executor &operator=( const Executor & ) = delete;
+
+            void start( unsigned int count );
+            void stop();
+            void submit( Job &&job );
+            unsigned int getDepth();
+    };
+
+    Executor::~Executor() {
+        stop();
+    }
+
+    void Executor::_work() {
+        Job job;
+
+        while( true ) {
+            {
+                std::unique_lock<std::mutex> lock( _m );
+                _cv.wait( lock, [this] { return _isStop || !_jobs.empty(); } );
+
+                if( _jobs.empty() ) {
+                    return;
+                }
+
+                job = std::move( _jobs.front() );
+                _jobs.pop_front();
+            }
+
+            job();
+            job = nullptr;
+            _depth--;
+        }
+    }
+
+    void Executor::start( unsigned int count ) {
+        for( unsigned int i = 0; i < count; i++ ) {
+            _threads.emplace_back( &Executor::_work, this );
+        }
+    }
+
+    void Executor::stop() {
+        {
+            std::lock_guard<std::mutex> lock( _m );
+            _isStop = true;
+        }
+
+        _cv.notify_all();
+
+        for( auto &thread : _threads ) {
+            thread.join();
+        }
+
+        _threads.clear();
+    }
+
+    void Executor::submit( Job &&job ) {
+        _depth++;
+
+        if( _threads.empty() ) {
+            job();
+            _depth--;
+
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock( _m );
+            _jobs.push_back( std::move( job ) );
+        }
+
+        _cv.notify_one();
+    }
+
+    unsigned int Executor::getDepth() {
+        return _depth;
+    }
+}
+
+#endif
@@ -0,0 +1,599 @@
+#ifndef MEMSESS_UTIL_FLAT_MAP
+#define MEMSESS_UTIL_FLAT_MAP
+
+#include <memory>
+#include <atomic>
+#include <vector>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include "epoch.hpp"
+#include "allocations.hpp"
+
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
+namespace memsess::util {
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    class FlatMap {
+        public:
+            static const unsigned int GROUP = 16;
+
+        private:
+            static const signed char EMPTY = -128;
+            static const signed char DELETED = -2;
+            static const unsigned int COUNT_MIGRATE_GROUPS = 4;
+            static const unsigned int COUNT_SHRINK_GROUPS = 256;
+
+            struct Table {
+                unsigned long int countGroups;
+                unsigned int shift;
+                std::atomic<unsigned long int> maxProbe{0};
+                std::unique_ptr<signed char[]> ctrl;
+                std::atomic<Value> *slots;
+
+                ~Table() {
+                    ::free( slots );
+                }
+            };
+
+            std::atomic<Table *> _table;
+            std::atomic<Table *> _tableOld{nullptr};
+            unsigned long int _indexMigrate = 0;
+            unsigned long int _countMigrate = COUNT_MIGRATE_GROUPS;
+            unsigned long int _countGroupsMin;
+            unsigned long int _size = 0;
+            unsigned long int _deleted = 0;
+            Hash _hash;
+            KeyOf _keyOf;
+
+            static Table *_createTable( unsigned long int countGroups );
+            static void _freeTable( void *ctx, void *ptr, unsigned int size );
+            void _resize( unsigned long int countGroups );
+            void _migrate( unsigned long int countGroups );
+            void _reserveOne();
+            Table *_getTable( unsigned long int &index );
+            static unsigned long int _getGroup( Table *table, unsigned long int hash );
+            unsigned long int _findIndex( Table *table, const Key &key, unsigned long int hash );
+            void _place( Table *table, Value value, unsigned long int hash );
+            void _clear( Table *table, unsigned long int index, bool isTombstone );
+            static Value _sample( Table *table, unsigned long int seed, unsigned int limit );
+            void _scan( Table *table, unsigned long int from, unsigned long int to, std::vector<Value> &values );
+            static unsigned int _match( const signed char *ctrl, signed char value );
+            static unsigned int _matchFree( const signed char *ctrl );
+            static unsigned long int _getCountGroups( unsigned long int count );
+
+        public:
+            static const unsigned long int NONE = ~0UL;
+
+            FlatMap( unsigned long int count = 0 );
+            ~FlatMap();
+            FlatMap( const FlatMap & ) = delete;
+            FlatMap &operator=( const FlatMap & ) = delete;
+
+            Value find( const Key &key );
+            bool insert( Value value );
+            Value erase( const Key &key );
+            void eraseAt( unsigned long int index );
+            void reserve( unsigned long int count );
+            unsigned long int shrink();
+
+            unsigned long int size();
+            unsigned long int capacity();
+            unsigned long int getBytes();
+            bool isFull( unsigned long int index );
+            Key getKey( unsigned long int index );
+            Value getValue( unsigned long int index );
+            Value sample( unsigned long int seed, unsigned int limit );
+            unsigned long int scan( unsigned long int cursor, unsigned int count, std::vector<Value> &values );
+    };
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    FlatMap<Key, Value, Hash, KeyOf>::FlatMap( unsigned long int count ) {
+        _countGroupsMin = _getCountGroups( count );
+        _table = _createTable( _countGroupsMin );
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    FlatMap<Key, Value, Hash, KeyOf>::~FlatMap() {
+        delete _table.load();
+        delete _tableOld.load();
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    unsigned long int FlatMap<Key, Value, Hash, KeyOf>::_getCountGroups( unsigned long int count ) {
+        unsigned long int countGroups = 1;
+        auto slots = count + count / 7;
+
+        while( countGroups * GROUP < slots ) {
+            countGroups *= 2;
+        }
+
+        return countGroups;
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    typename FlatMap<Key, Value, Hash, KeyOf>::Table *FlatMap<Key, Value, Hash, KeyOf>::_createTable(
+        unsigned long int countGroups
+    ) {
+        auto table = new Table;
+
+        table->countGroups = countGroups;
+        table->shift = 64 - __builtin_ctzl( countGroups );
+        table->ctrl = std::make_unique<signed char[]>( countGroups * GROUP );
+        table->slots = ( std::atomic<Value> * )Allocations::calloc( countGroups * GROUP, sizeof( std::atomic<Value> ) );
+        memset( table->ctrl.get(), EMPTY, countGroups * GROUP );
+
+        return table;
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    void FlatMap<Key, Value, Hash, KeyOf>::_freeTable( void *, void *ptr, unsigned int ) {
+        delete ( Table * )ptr;
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    unsigned long int FlatMap<Key, Value, Hash, KeyOf>::_getGroup( Table *table, unsigned long int hash ) {
+        if( table->countGroups == 1 ) {
+            return 0;
+        }
+
+        return hash >> table->shift;
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    unsigned int FlatMap<Key, Value, Hash, KeyOf>::_match( const signed char *ctrl, signed char value ) {
+#if defined( __SSE2__ )
+        auto group = _mm_loadu_si128( ( const __m128i * )ctrl );
+
+        return _mm_movemask_epi8( _mm_cmpeq_epi8( group, _mm_set1_epi8( value ) ) );
+#else
+        unsigned int mask = 0;
+
+        for( unsigned int i = 0; i < GROUP; i++ ) {
+            if( ctrl[i] == value ) {
+                mask |= 1 << i;
+            }
+        }
+
+        return mask;
+#endif
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    unsigned int FlatMap<Key, Value, Hash, KeyOf>::_matchFree( const signed char *ctrl ) {
+#if defined( __SSE2__ )
+        return _mm_movemask_epi8( _mm_loadu_si128( ( const __m128i * )ctrl ) );
+#else
+        unsigned int mask = 0;
+
+        for( unsigned int i = 0; i < GROUP; i++ ) {
+            if( ctrl[i] < 0 ) {
+                mask |= 1 << i;
+            }
+        }
+
+        return mask;
+#endif
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    unsigned long int FlatMap<Key, Value, Hash, KeyOf>::_findIndex(
+        Table *table,
+        const Key &key,
+        unsigned long int hash
+    ) {
+        signed char h2 = hash & 0x7F;
+        auto group = _getGroup( table, hash );
+        auto maxProbe = table->maxProbe.load( std::memory_order_acquire );
+
+        for( unsigned long int probe = 0; probe <= maxProbe; probe++ ) {
+            auto offset = ( ( group + probe ) & ( table->countGroups - 1 ) ) * GROUP;
+            auto ctrl = &table->ctrl[offset];
+
+            for( auto mask = _match( ctrl, h2 ); mask != 0; mask &= mask - 1 ) {
+                auto index = offset + __builtin_ctz( mask );
+                auto value = table->slots[index].load( std::memory_order_acquire );
+
+                if( value != nullptr && _keyOf( value ) == key ) {
+                    return index;
+                }
+            }
+
+            if( _match( ctrl, EMPTY ) != 0 ) {
+                break;
+            }
+        }
+
+        return NONE;
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    void FlatMap<Key, Value, Hash, KeyOf>::_place( Table *table, Value value, unsigned long int hash ) {
+        auto group = _getGroup( table, hash );
+
+        for( unsigned long int probe = 0; probe < table->countGroups; probe++ ) {
+            auto offset = ( ( group + probe ) & ( table->countGroups - 1 ) ) * GROUP;
+            auto mask = _matchFree( &table->ctrl[offset] );
+
+            if( mask == 0 ) {
+                continue;
+            }
+
+            auto index = offset + __builtin_ctz( mask );
+
+            if( table->ctrl[index] == DELETED ) {
+                _deleted--;
+            }
+
+            if( probe > table->maxProbe.load( std::memory_order_relaxed ) ) {
+                table->maxProbe.store( probe, std::memory_order_release );
+            }
+
+            table->slots[index].store( value, std::memory_order_release );
+            table->ctrl[index] = hash & 0x7F;
+            _size++;
+
+            return;
+        }
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    void FlatMap<Key, Value, Hash, KeyOf>::_resize( unsigned long int countGroups ) {
+        auto table = _table.load( std::memory_order_relaxed );
+        auto headroom = countGroups * GROUP * 7 / 8 - _size;
+
+        _countMigrate = std::max( table->countGroups / headroom + 1, ( unsigned long int )COUNT_MIGRATE_GROUPS );
+        _tableOld.store( table, std::memory_order_release );
+        _table.store( _createTable( countGroups ), std::memory_order_release );
+        _indexMigrate = 0;
+        _deleted = 0;
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    void FlatMap<Key, Value, Hash, KeyOf>::_migrate( unsigned long int countGroups ) {
+        auto tableOld = _tableOld.load( std::memory_order_relaxed );
+
+        if( tableOld == nullptr ) {
+            return;
+        }
+
+        auto table = _table.load( std::memory_order_relaxed );
+
+        for( unsigned long int i = 0; i < countGroups && _indexMigrate < tableOld->countGroups; i++ ) {
+            auto offset = _indexMigrate * GROUP;
+
+            for( unsigned int j = 0; j < GROUP; j++ ) {
+                if( tableOld->ctrl[offset + j] >= 0 ) {
+                    auto value = tableOld->slots[offset + j].load( std::memory_order_relaxed );
+
+                    _place( table, value, _hash( _keyOf( value ) ) );
+                    _size--;
+                    _clear( tableOld, offset + j, true );
+                }
+            }
+
+            _indexMigrate++;
+        }
+
+        if( _indexMigrate == tableOld->countGroups ) {
+            _tableOld.store( nullptr, std::memory_order_release );
+            Epoch::retire( _freeTable, nullptr, tableOld );
+        }
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    void FlatMap<Key, Value, Hash, KeyOf>::_reserveOne() {
+        _migrate( _countMigrate );
+
+        auto table = _table.load( std::memory_order_relaxed );
+        auto total = table->countGroups * GROUP;
+
+        if( ( _size + _deleted + 1 ) * 8 <= total * 7 || _tableOld.load( std::memory_order_relaxed ) != nullptr ) {
+            return;
+        }
+
+        if( _deleted > _size / 2 ) {
+            _resize( table->countGroups );
+        } else {
+            _resize( table->countGroups * 2 );
+        }
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    void FlatMap<Key, Value, Hash, KeyOf>::_clear( Table *table, unsigned long int index, bool isTombstone ) {
+        auto offset = index - index % GROUP;
+
+        table->slots[index].store( nullptr, std::memory_order_release );
+
+        if( isTombstone || _match( &table->ctrl[offset], EMPTY ) == 0 ) {
+            table->ctrl[index] = DELETED;
+        } else {
+            table->ctrl[index] = EMPTY;
+        }
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    typename FlatMap<Key, Value, Hash, KeyOf>::Table *FlatMap<Key, Value, Hash, KeyOf>::_getTable(
+        unsigned long int &index
+    ) {
+        auto table = _table.load( std::memory_order_relaxed );
+        auto capacity = table->countGroups * GROUP;
+
+        if( index < capacity ) {
+            return table;
+        }
+
+        index -= capacity;
+
+        return _tableOld.load( std::memory_order_relaxed );
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    Value FlatMap<Key, Value, Hash, KeyOf>::find( const Key &key ) {
+        auto hash = _hash( key );
+
+        while( true ) {
+            auto table = _table.load( std::memory_order_acquire );
+            auto tableOld = _tableOld.load( std::memory_order_acquire );
+
+            if( tableOld != nullptr && tableOld != table ) {
+                auto index = _findIndex( tableOld, key, hash );
+
+                if( index != NONE ) {
+                    auto value = tableOld->slots[index].load( std::memory_order_acquire );
+
+                    if( value != nullptr ) {
+                        return value;
+                    }
+                }
+            }
+
+            auto index = _findIndex( table, key, hash );
+
+            if( index != NONE ) {
+                auto value = table->slots[index].load( std::memory_order_acquire );
+
+                if( value != nullptr ) {
+                    return value;
+                }
+            }
+
+            if( _table.load( std::memory_order_acquire ) == table ) {
+                return nullptr;
+            }
+        }
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    bool FlatMap<Key, Value, Hash, KeyOf>::insert( Value value ) {
+        auto hash = _hash( _keyOf( value ) );
+        auto tableOld = _tableOld.load( std::memory_order_relaxed );
+
+        if( tableOld != nullptr && _findIndex( tableOld, _keyOf( value ), hash ) != NONE ) {
+            return false;
+        }
+
+        if( _findIndex( _table.load( std::memory_order_relaxed ), _keyOf( value ), hash ) != NONE ) {
+            return false;
+        }
+
+        _reserveOne();
+        _place( _table.load( std::memory_order_relaxed ), value, hash );
+
+        return true;
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    Value FlatMap<Key, Value, Hash, KeyOf>::erase( const Key &key ) {
+        auto hash = _hash( key );
+
+        _migrate( _countMigrate );
+
+        auto tableOld = _tableOld.load( std::memory_order_relaxed );
+
+        if( tableOld != nullptr ) {
+            auto index = _findIndex( tableOld, key, hash );
+
+            if( index != NONE ) {
+                auto value = tableOld->slots[index].load( std::memory_order_relaxed );
+
+                _clear( tableOld, index, true );
+                _size--;
+
+                return value;
+            }
+        }
+
+        auto table = _table.load( std::memory_order_relaxed );
+        auto index = _findIndex( table, key, hash );
+
+        if( index == NONE ) {
+            return nullptr;
+        }
+
+        auto value = table->slots[index].load( std::memory_order_relaxed );
+        eraseAt( index );
+
+        return value;
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    void FlatMap<Key, Value, Hash, KeyOf>::eraseAt( unsigned long int index ) {
+        auto table = _table.load( std::memory_order_relaxed );
+        auto tableIndex = _getTable( index );
+
+        _clear( tableIndex, index, tableIndex != table );
+
+        if( tableIndex == table && table->ctrl[index] == DELETED ) {
+            _deleted++;
+        }
+
+        _size--;
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    void FlatMap<Key, Value, Hash, KeyOf>::reserve( unsigned long int count ) {
+        auto countGroups = _getCountGroups( count );
+
+        if( countGroups > _countGroupsMin ) {
+            _countGroupsMin = countGroups;
+        }
+
+        if( countGroups > _table.load( std::memory_order_relaxed )->countGroups && _tableOld.load( std::memory_order_relaxed ) == nullptr ) {
+            _resize( countGroups );
+        }
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    unsigned long int FlatMap<Key, Value, Hash, KeyOf>::shrink() {
+        auto table = _table.load( std::memory_order_relaxed );
+        auto bytes = getBytes();
+
+        if( _tableOld.load( std::memory_order_relaxed ) == nullptr ) {
+            auto countGroups = std::max( { _getCountGroups( _size * 2 ), _countGroupsMin, table->countGroups / 16 } );
+
+            if( _size * 4 > table->countGroups * GROUP || countGroups >= table->countGroups ) {
+                return 0;
+            }
+
+            _resize( countGroups );
+        }
+
+        _migrate( COUNT_SHRINK_GROUPS );
+
+        auto bytesCur = getBytes();
+
+        return bytes > bytesCur ? bytes - bytesCur : 0;
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    unsigned long int FlatMap<Key, Value, Hash, KeyOf>::size() {
+        return _size;
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    unsigned long int FlatMap<Key, Value, Hash, KeyOf>::capacity() {
+        auto capacity = _table.load( std::memory_order_relaxed )->countGroups * GROUP;
+        auto tableOld = _tableOld.load( std::memory_order_relaxed );
+
+        if( tableOld != nullptr ) {
+            capacity += tableOld->countGroups * GROUP;
+        }
+
+        return capacity;
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    unsigned long int FlatMap<Key, Value, Hash, KeyOf>::getBytes() {
+        auto countTables = _tableOld.load( std::memory_order_relaxed ) != nullptr ? 2 : 1;
+
+        return sizeof( Table ) * countTables + capacity() * ( sizeof( signed char ) + sizeof( std::atomic<Value> ) );
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    bool FlatMap<Key, Value, Hash, KeyOf>::isFull( unsigned long int index ) {
+        return _getTable( index )->ctrl[index] >= 0;
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    Key FlatMap<Key, Value, Hash, KeyOf>::getKey( unsigned long int index ) {
+        return _keyOf( getValue( index ) );
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    Value FlatMap<Key, Value, Hash, KeyOf>::getValue( unsigned long int index ) {
+        return _getTable( index )->slots[index].load( std::memory_order_relaxed );
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    Value FlatMap<Key, Value, Hash, KeyOf>::sample( unsigned long int seed, unsigned int limit ) {
+        auto tableOld = _tableOld.load( std::memory_order_acquire );
+
+        if( tableOld != nullptr ) {
+            auto value = _sample( tableOld, seed, limit );
+
+            if( value != nullptr ) {
+                return value;
+            }
+        }
+
+        return _sample( _table.load( std::memory_order_acquire ), seed, limit );
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    Value FlatMap<Key, Value, Hash, KeyOf>::_sample( Table *table, unsigned long int seed, unsigned int limit ) {
+        auto capacity = table->countGroups * GROUP;
+
+        for( unsigned int i = 0; i < limit && i < capacity; i++ ) {
+            auto value = table->slots[( seed + i ) % capacity].load( std::memory_order_acquire );
+
+            if( value != nullptr ) {
+                return value;
+            }
+        }
+
+        return nullptr;
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    unsigned long int FlatMap<Key, Value, Hash, KeyOf>::scan(
+        unsigned long int cursor,
+        unsigned int count,
+        std::vector<Value> &values
+    ) {
+        auto table = _table.load( std::memory_order_relaxed );
+        auto tableOld = _tableOld.load( std::memory_order_relaxed );
+        auto size = values.size();
+
+        while( values.size() - size < count ) {
+            auto group = _getGroup( table, cursor );
+            auto next = group + 1 == table->countGroups ? 0 : ( group + 1 ) << table->shift;
+
+            if( tableOld != nullptr ) {
+                _scan( tableOld, cursor, next, values );
+            }
+
+            _scan( table, cursor, next, values );
+            cursor = next;
+
+            if( cursor == 0 ) {
+                break;
+            }
+        }
+
+        return cursor;
+    }
+
+    template<typename Key, typename Value, typename Hash, typename KeyOf>
+    void FlatMap<Key, Value, Hash, KeyOf>::_scan(
+        Table *table,
+        unsigned long int from,
+        unsigned long int to,
+        std::vector<Value> &values
+    ) {
+        auto first = _getGroup( table, from );
+        auto last = to == 0 ? table->countGroups - 1 : _getGroup( table, to - 1 );
+        auto countGroups = std::min( last - first + 1 + table->maxProbe.load( std::memory_order_relaxed ), table->countGroups );
+
+        for( unsigned long int i = 0; i < countGroups; i++ ) {
+            auto offset = ( ( first + i ) & ( table->countGroups - 1 ) ) * GROUP;
+
+            for( unsigned int j = 0; j < GROUP; j++ ) {
+                if( table->ctrl[offset + j] < 0 ) {
+                    continue;
+                }
+
+                auto value = table->slots[offset + j].load( std::memory_order_relaxed );
+                auto hash = _hash( _keyOf( value ) );
+
+                if( hash >= from && ( to == 0 || hash < to ) ) {
+                    values.push_back( value );
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef MEMSESS_UTIL_LOCK_TABLE
+#define MEMSESS_UTIL_LOCK_TABLE
+
+#include <memory>
+
+namespace memsess::util {
+    template<typename Lock>
+    class LockTable {
+        private:
+            struct alignas( 64 ) Stripe {
+                Lock m;
+            };
+
+            std::unique_ptr<Stripe[]> _stripes;
+            unsigned int _shift;
+
+        public:
+            LockTable( unsigned int bits );
+            Lock &get( const void *ptr );
+            unsigned long int getBytes();
+    };
+
+    template<typename Lock>
+    LockTable<Lock>::LockTable( unsigned int bits ) {
+        _stripes = std::make_unique<Stripe[]>( 1UL << bits );
+        _shift = 64 - bits;
+    }
+
+    template<typename Lock>
+    Lock &LockTable<Lock>::get( const void *ptr ) {
+        auto hash = ( ( unsigned long int )ptr >> 4 ) * 0x9E'37'79'B9'7F'4A'7C'15UL;
+
+        return _stripes[hash >> _shift].m;
+    }
+
+    template<typename Lock>
+    unsigned long int LockTable<Lock>::getBytes() {
+        return sizeof( Stripe ) << ( 64 - _shift );
+    }
+}
+
+#endif
@@ -0,0 +1,216 @@
+#ifndef MEMSESS_UTIL_LZ
+#define MEMSESS_UTIL_LZ
+
+#include <string.h>
+
+namespace memsess::util {
+    class LZ {
+        private:
+            static const unsigned int BITS_TABLE = 12;
+            static const unsigned int SIZE_TABLE = 1 << BITS_TABLE;
+            static const unsigned int MIN_MATCH = 4;
+            static const unsigned int LAST_LITERALS = 5;
+            static const unsigned int MF_LIMIT = 12;
+            static const unsigned int MAX_OFFSET = 0xFF'FF;
+            static const unsigned int SKIP_TRIGGER = 6;
+
+            static unsigned int _read( const unsigned char *data );
+            static unsigned int _hash( unsigned int value );
+            static unsigned int _writeLength( unsigned char *dst, unsigned int length );
+            static bool _readLength( const unsigned char *src, unsigned int length, unsigned int &ip, unsigned int &value );
+
+        public:
+            static unsigned int getBound( unsigned int length );
+            static unsigned int compress( const char *src, unsigned int length, char *dst );
+            static bool decompress( const char *src, unsigned int length, char *dst, unsigned int lengthOriginal );
+    };
+
+    unsigned int LZ::_read( const unsigned char *data ) {
+        unsigned int value;
+
+        memcpy( &value, data, sizeof( value ) );
+
+        return value;
+    }
+
+    unsigned int LZ::_hash( unsigned int value ) {
+        return ( value * 2'654'435'761U ) >> ( 32 - BITS_TABLE );
+    }
+
+    unsigned int LZ::_writeLength( unsigned char *dst, unsigned int length ) {
+        unsigned int op = 0;
+
+        while( length >= 0xFF ) {
+            dst[op++] = 0xFF;
+            length -= 0xFF;
+        }
+
+        dst[op++] = length;
+
+        return op;
+    }
+
+    bool LZ::_readLength( const unsigned char *src, unsigned int length, unsigned int &ip, unsigned int &value ) {
+        unsigned char byte;
+
+        do {
+            if( ip >= length ) {
+                return false;
+            }
+
+            byte = src[ip++];
+            value += byte;
+        } while( byte == 0xFF );
+
+        return true;
+    }
+
+    unsigned int LZ::getBound( unsigned int length ) {
+        return length + length / 0xFF + 16;
+    }
+
+    unsigned int LZ::compress( const char *src, unsigned int length, char *dst ) {
+        auto in = ( const unsigned char * )src;
+        auto out = ( unsigned char * )dst;
+        unsigned int table[SIZE_TABLE] = {};
+        unsigned int ip = 0;
+        unsigned int op = 0;
+        unsigned int anchor = 0;
+
+        if( length > MF_LIMIT ) {
+            auto limit = length - MF_LIMIT;
+            auto limitMatch = length - LAST_LITERALS;
+            unsigned int searches = 1 << SKIP_TRIGGER;
+
+            while( ip < limit ) {
+                auto value = _read( &in[ip] );
+                auto hash = _hash( value );
+                auto ref = table[hash];
+
+                table[hash] = ip;
+
+                if( ref >= ip || ip - ref > MAX_OFFSET || _read( &in[ref] ) != value ) {
+                    ip += searches++ >> SKIP_TRIGGER;
+                    continue;
+                }
+
+                searches = 1 << SKIP_TRIGGER;
+
+                while( ip > anchor && ref > 0 && in[ip - 1] == in[ref - 1] ) {
+                    ip--;
+                    ref--;
+                }
+
+                auto lengthMatch = MIN_MATCH;
+
+                while( ip + lengthMatch < limitMatch && in[ref + lengthMatch] == in[ip + lengthMatch] ) {
+                    lengthMatch++;
+                }
+
+                auto lengthLiterals = ip - anchor;
+                auto token = &out[op++];
+
+                if( lengthLiterals >= 0x0F ) {
+                    *token = 0xF0;
+                    op += _writeLength( &out[op], lengthLiterals - 0x0F );
+                } else {
+                    *token = lengthLiterals << 4;
+                }
+
+                memcpy( &out[op], &in[anchor], lengthLiterals );
+                op += lengthLiterals;
+
+                out[op++] = ( ip - ref ) & 0xFF;
+                out[op++] = ( ip - ref ) >> 8;
+
+                if( lengthMatch - MIN_MATCH >= 0x0F ) {
+                    *token |= 0x0F;
+                    op += _writeLength( &out[op], lengthMatch - MIN_MATCH - 0x0F );
+                } else {
+                    *token |= lengthMatch - MIN_MATCH;
+                }
+
+                ip += lengthMatch;
+                anchor = ip;
+            }
+        }
+
+        auto lengthLiterals = length - anchor;
+        auto token = &out[op++];
+
+        if( lengthLiterals >= 0x0F ) {
+            *token = 0xF0;
+            op += _writeLength( &out[op], lengthLiterals - 0x0F );
+        } else {
+            *token = lengthLiterals << 4;
+        }
+
+        memcpy( &out[op], &in[anchor], lengthLiterals );
+
+        return op + lengthLiterals;
+    }
+
+    bool LZ::decompress( const char *src, unsigned int length, char *dst, unsigned int lengthOriginal ) {
+        auto in = ( const unsigned char * )src;
+        auto out = ( unsigned char * )dst;
+        unsigned int ip = 0;
+        unsigned int op = 0;
+
+        while( ip < length ) {
+            auto token = in[ip++];
+            unsigned int lengthLiterals = token >> 4;
+
+            if( lengthLiterals == 0x0F && !_readLength( in, length, ip, lengthLiterals ) ) {
+                return false;
+            }
+
+            if( lengthLiterals > length - ip || lengthLiterals > lengthOriginal - op ) {
+                return false;
+            }
+
+            memcpy( &out[op], &in[ip], lengthLiterals );
+            ip += lengthLiterals;
+            op += lengthLiterals;
+
+            if( ip == length ) {
+                break;
+            }
+
+            if( length - ip < 2 ) {
+                return false;
+            }
+
+            unsigned int offset = in[ip] | ( in[ip + 1] << 8 );
+            unsigned int lengthMatch = token & 0x0F;
+            ip += 2;
+
+            if( offset == 0 || offset > op ) {
+                return false;
+            }
+
+            if( lengthMatch == 0x0F && !_readLength( in, length, ip, lengthMatch ) ) {
+                return false;
+            }
+
+            lengthMatch += MIN_MATCH;
+
+            if( lengthMatch > lengthOriginal - op ) {
+                return false;
+            }
+
+            if( offset >= lengthMatch ) {
+                memcpy( &out[op], &out[op - offset], lengthMatch );
+            } else {
+                for( unsigned int i = 0; i < lengthMatch; i++ ) {
+                    out[op + i] = out[op - offset + i];
+                }
+            }
+
+            op += lengthMatch;
+        }
+
+        return op == lengthOriginal;
+    }
+}
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef MEMSESS_UTIL_PAYLOAD
+#define MEMSESS_UTIL_PAYLOAD
+
+#include <string.h>
+#include <new>
+#include "epoch.hpp"
+
+#include <atomic>
+
+namespace memsess::util {
+    class Payload {
+        private:
+            std::atomic_uint _refs{1};
+            unsigned int _length;
+            unsigned int _lengthOriginal;
+            Epoch::Free _free;
+            void *_ctx;
+
+            Payload( unsigned int length, unsigned int lengthOriginal, Epoch::Free free, void *ctx );
+
+        public:
+            static unsigned int getSize( unsigned int length );
+            static Payload *create(
+                void *ptr,
+                const char *data,
+                unsigned int length,
+                Epoch::Free free,
+                void *ctx,
+                unsigned int lengthOriginal = 0
+            );
+
+            char *getData();
+            unsigned int getLength();
+            unsigned int getLengthOriginal();
+            void *getContext();
+            bool acquire();
+            void release();
+    };
+
+    class PayloadRef {
+        public:
+            static const unsigned int SIZE_INLINE = 48;
+
+        private:
+            Payload *_payload = nullptr;
+            unsigned int _length = 0;
+            char _inline[SIZE_INLINE];
+
+        public:
+            PayloadRef() = default;
+            PayloadRef( PayloadRef &&ref );
+            PayloadRef &operator=( PayloadRef &&ref );
+            PayloadRef( const PayloadRef & ) = delete;
+            PayloadRef &operator=( const PayloadRef & ) = delete;
+            ~PayloadRef();
+
+            void set( Payload *payload );
+            void copy( const char *data, unsigned int length );
+            void reset();
+
+            const char *getData();
+            unsigned int getLength();
+            unsigned int getLengthOriginal();
+    };
+
+    Payload::Payload( unsigned int length, unsigned int lengthOriginal, Epoch::Free free, void *ctx ) {
+        _length = length;
+        _lengthOriginal = lengthOriginal;
+        _free = free;
+        _ctx = ctx;
+    }
+
+    unsigned int Payload::getSize( unsigned int length ) {
+        return sizeof( Payload ) + length;
+    }
+
+    Payload *Payload::create(
+        void *ptr,
+        const char *data,
+        unsigned int length,
+        Epoch::Free free,
+        void *ctx,
+        unsigned int lengthOriginal
+    ) {
+        auto payload = new ( ptr ) Payload( length, lengthOriginal, free, ctx );
+
+        if( data != nullptr ) {
+            memcpy( payload->getData(), data, length );
+        }
+
+        return payload;
+    }
+
+    char *Payload::getData() {
+        return ( char * )this + sizeof( Payload );
+    }
+
+    unsigned int Payload::getLength() {
+        return _length;
+    }
+
+    unsigned int Payload::getLengthOriginal() {
+        return _lengthOriginal;
+    }
+
+    void *Payload::getContext() {
+        return _ctx;
+    }
+
+    bool Payload::acquire() {
+        auto refs = _refs.load();
+
+        do {
+            if( refs == 0 ) {
+                return false;
+            }
+        } while( !_refs.compare_exchange_weak( refs, refs + 1 ) );
+
+        return true;
+    }
+
+    void Payload::release() {
+        if( --_refs == 0 ) {
+            Epoch::retire( _free, _ctx, this, getSize( _length ) );
+        }
+    }
+
+    PayloadRef::PayloadRef( PayloadRef &&ref ) {
+        *this = std::move( ref );
+    }
+
+    PayloadRef &PayloadRef::operator=( PayloadRef &&ref ) {
+        if( this == &ref ) {
+            return *this;
+        }
+
+        reset();
+
+        _payload = ref._payload;
+        _length = ref._length;
+
+        if( _payload == nullptr ) {
+            memcpy( _inline, ref._inline, _length );
+        }
+
+        ref._payload = nullptr;
+        ref._length = 0;
+
+        return *this;
+    }
+
+    PayloadRef::~PayloadRef() {
+        reset();
+    }
+
+    void PayloadRef::set( Payload *payload ) {
+        reset();
+
+        _payload = payload;
+        _length = payload->getLength();
+    }
+
+    void PayloadRef::copy( const char *data, unsigned int length ) {
+        reset();
+
+        memcpy( _inline, data, length );
+        _length = length;
+    }
+
+    void PayloadRef::reset() {
+        if( _payload != nullptr ) {
+            _payload->release();
+            _payload = nullptr;
+        }
+
+        _length = 0;
+    }
+
+    const char *PayloadRef::getData() {
+        if( _payload != nullptr ) {
+            return _payload->getData();
+        }
+
+        return _inline;
+    }
+
+    unsigned int PayloadRef::getLength() {
+        return _length;
+    }
+
+    unsigned int PayloadRef::getLengthOriginal() {
+        if( _payload != nullptr ) {
+            return _payload->getLengthOriginal();
+        }
+
+        return 0;
+    }
+}
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef MEMSESS_UTIL_POLICY
+#define MEMSESS_UTIL_POLICY
+
+#include <atomic>
+#include <mutex>
+#include "rw_lock.hpp"
+
+namespace memsess::util {
+    class NoLock {
+        public:
+            void lock();
+            void unlock();
+            void lock_shared();
+            void unlock_shared();
+    };
+
+    template<typename T>
+    class Plain {
+        private:
+            T _value;
+
+        public:
+            Plain( T value = T() );
+            Plain( const Plain & ) = delete;
+            Plain &operator=( const Plain & ) = delete;
+
+            T load( std::memory_order = std::memory_order_seq_cst ) const;
+            void store( T value, std::memory_order = std::memory_order_seq_cst );
+            T exchange( T value, std::memory_order = std::memory_order_seq_cst );
+            T fetch_add( T value, std::memory_order = std::memory_order_seq_cst );
+            T fetch_sub( T value, std::memory_order = std::memory_order_seq_cst );
+            bool compare_exchange_weak( T &expected, T desired, std::memory_order = std::memory_order_seq_cst );
+
+            operator T() const;
+            T operator=( T value );
+            T operator++();
+            T operator++( int );
+            T operator--();
+            T operator--( int );
+            T operator+=( T value );
+            T operator-=( T value );
+    };
+
+    struct PolicyMulti {
+        static const bool IS_MULTI = true;
+        typedef RWLock Lock;
+        typedef std::mutex Mutex;
+
+        template<typename T>
+        using Atomic = std::atomic<T>;
+    };
+
+    struct PolicyMono {
+        static const bool IS_MULTI = false;
+        typedef NoLock Lock;
+        typedef NoLock Mutex;
+
+        template<typename T>
+        using Atomic = Plain<T>;
+    };
+
+    void NoLock::lock() {
+    }
+
+    void NoLock::unlock() {
+    }
+
+    void NoLock::lock_shared() {
+    }
+
+    void NoLock::unlock_shared() {
+    }
+
+    template<typename T>
+    Plain<T>::Plain( T value ) : _value( value ) {
+    }
+
+    template<typename T>
+    T Plain<T>::load( std::memory_order ) const {
+        return _value;
+    }
+
+    template<typename T>
+    void Plain<T>::store( T value, std::memory_order ) {
+        _value = value;
+    }
+
+    template<typename T>
+    T Plain<T>::exchange( T value, std::memory_order ) {
+        auto result = _value;
+        _value = value;
+
+        return result;
+    }
+
+    template<typename T>
+    T Plain<T>::fetch_add( T value, std::memory_order ) {
+        auto result = _value;
+        _value += value;
+
+        return result;
+    }
+
+    template<typename T>
+    T Plain<T>::fetch_sub( T value, std::memory_order ) {
+        auto result = _value;
+        _value -= value;
+
+        return result;
+    }
+
+    template<typename T>
+    bool Plain<T>::compare_exchange_weak( T &expected, T desired, std::memory_order ) {
+        if( _value != expected ) {
+            expected = _value;
+
+            return false;
+        }
+
+        _value = desired;
+
+        return true;
+    }
+
+    template<typename T>
+    Plain<T>::operator T() const {
+        return _value;
+    }
+
+    template<typename T>
+    T Plain<T>::operator=( T value ) {
+        _value = value;
+
+        return value;
+    }
+
+    template<typename T>
+    T Plain<T>::operator++() {
+        return ++_value;
+    }
+
+    template<typename T>
+    T Plain<T>::operator++( int ) {
+        return _value++;
+    }
+
+    template<typename T>
+    T Plain<T>::operator--() {
+        return --_value;
+    }
+
+    template<typename T>
+    T Plain<T>::operator--( int ) {
+        return _value--;
+    }
+
+    template<typename T>
+    T Plain<T>::operator+=( T value ) {
+        return _value += value;
+    }
+
+    template<typename T>
+    T Plain<T>::operator-=( T value ) {
+        return _value -= value;
+    }
+}
+
+#endif
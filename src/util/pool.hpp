@@ -0,0 +1,130 @@
+#ifndef MEMSESS_UTIL_POOL
+#define MEMSESS_UTIL_POOL
+
+#include <unordered_map>
+#include <string_view>
+#include <stdlib.h>
+#include <string.h>
+#include "payload.hpp"
+#include "allocations.hpp"
+
+#include <mutex>
+
+namespace memsess::util {
+    template<typename Policy>
+    class Pool {
+        private:
+            struct Entry {
+                Pool *pool;
+                unsigned long int hash;
+                Payload *payload;
+                typename Policy::template Atomic<unsigned long int> references{0};
+            };
+
+            std::unordered_map<unsigned long int, Entry *> _entries;
+            typename Policy::Mutex _m;
+            typename Policy::template Atomic<unsigned long int> _bytes{0};
+
+            static unsigned long int _hash( const char *data, unsigned int length, unsigned int lengthOriginal );
+            static void _free( void *ctx, void *ptr, unsigned int size );
+
+        public:
+            Pool() = default;
+            ~Pool();
+            Pool( const Pool & ) = delete;
+            Pool &operator=( const Pool & ) = delete;
+
+            Payload *get( const char *data, unsigned int length, unsigned int lengthOriginal = 0 );
+            void reference( Payload *payload );
+            void unreference( Payload *payload );
+            unsigned long int getBytes();
+    };
+
+    template<typename Policy>
+    Pool<Policy>::~Pool() {
+        for( auto &item : _entries ) {
+            ::free( item.second->payload );
+            delete item.second;
+        }
+    }
+
+    template<typename Policy>
+    unsigned long int Pool<Policy>::_hash( const char *data, unsigned int length, unsigned int lengthOriginal ) {
+        return std::hash<std::string_view>{}( std::string_view( data, length ) ) ^ lengthOriginal;
+    }
+
+    template<typename Policy>
+    void Pool<Policy>::_free( void *ctx, void *ptr, unsigned int ) {
+        auto entry = ( Entry * )ctx;
+        auto pool = entry->pool;
+
+        {
+            std::lock_guard<typename Policy::Mutex> lock( pool->_m );
+            auto it = pool->_entries.find( entry->hash );
+
+            if( it != pool->_entries.end() && it->second == entry ) {
+                pool->_entries.erase( it );
+            }
+        }
+
+        ::free( ptr );
+        delete entry;
+    }
+
+    template<typename Policy>
+    Payload *Pool<Policy>::get( const char *data, unsigned int length, unsigned int lengthOriginal ) {
+        auto hash = _hash( data, length, lengthOriginal );
+
+        std::lock_guard<typename Policy::Mutex> lock( _m );
+        auto it = _entries.find( hash );
+
+        if( it != _entries.end() ) {
+            auto payload = it->second->payload;
+
+            if(
+                payload->getLength() != length ||
+                payload->getLengthOriginal() != lengthOriginal ||
+                memcmp( payload->getData(), data, length ) != 0
+            ) {
+                return nullptr;
+            }
+
+            if( payload->acquire() ) {
+                return payload;
+            }
+        }
+
+        auto entry = new Entry{ this, hash, nullptr };
+        auto ptr = Allocations::malloc( Payload::getSize( length ) );
+
+        entry->payload = Payload::create( ptr, data, length, _free, entry, lengthOriginal );
+        _entries[hash] = entry;
+
+        return entry->payload;
+    }
+
+    template<typename Policy>
+    void Pool<Policy>::reference( Payload *payload ) {
+        auto entry = ( Entry * )payload->getContext();
+
+        if( entry->references++ == 0 ) {
+            _bytes += Payload::getSize( payload->getLength() );
+        }
+    }
+
+    template<typename Policy>
+    void Pool<Policy>::unreference( Payload *payload ) {
+        auto entry = ( Entry * )payload->getContext();
+
+        if( --entry->references == 0 ) {
+            _bytes -= Payload::getSize( payload->getLength() );
+        }
+    }
+
+    template<typename Policy>
+    unsigned long int Pool<Policy>::getBytes() {
+        return _bytes;
+    }
+}
+
+#endif
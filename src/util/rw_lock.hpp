@@ -0,0 +1,117 @@
+#ifndef MEMSESS_UTIL_RW_LOCK
+#define MEMSESS_UTIL_RW_LOCK
+
+#include <atomic>
+#include <climits>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
+namespace memsess::util {
+    class RWLock {
+        private:
+            static const unsigned int MASK_READERS = 0xFF'FF;
+            static const unsigned int WRITER_PENDING = 1 << 16;
+            static const unsigned int MASK_PENDING = 0x3F'FF << 16;
+            static const unsigned int WRITER = 1 << 30;
+            static const unsigned int COUNT_SPIN = 128;
+
+            std::atomic<unsigned int> _state = 0;
+            std::atomic<unsigned int> _waiters = 0;
+
+            void _park( unsigned int state );
+            void _wake();
+            static void _pause();
+
+        public:
+            void lock();
+            void unlock();
+            void lock_shared();
+            void unlock_shared();
+    };
+
+    void RWLock::_pause() {
+#if defined( __SSE2__ )
+        _mm_pause();
+#endif
+    }
+
+    void RWLock::_park( unsigned int state ) {
+        _waiters++;
+
+        if( _state == state ) {
+            syscall( SYS_futex, &_state, FUTEX_WAIT_PRIVATE, state, nullptr, nullptr, 0 );
+        }
+
+        _waiters--;
+    }
+
+    void RWLock::_wake() {
+        if( _waiters != 0 ) {
+            syscall( SYS_futex, &_state, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0 );
+        }
+    }
+
+    void RWLock::lock() {
+        auto state = _state.fetch_add( WRITER_PENDING ) + WRITER_PENDING;
+
+        for( unsigned int i = 0; ; i++ ) {
+            if( ( state & ( WRITER | MASK_READERS ) ) == 0 ) {
+                if( _state.compare_exchange_weak( state, ( state - WRITER_PENDING ) | WRITER ) ) {
+                    return;
+                }
+
+                continue;
+            }
+
+            if( i < COUNT_SPIN ) {
+                _pause();
+            } else {
+                _park( state );
+            }
+
+            state = _state;
+        }
+    }
+
+    void RWLock::unlock() {
+        _state -= WRITER;
+        _wake();
+    }
+
+    void RWLock::lock_shared() {
+        unsigned int state = _state;
+
+        for( unsigned int i = 0; ; i++ ) {
+            if( ( state & ( WRITER | MASK_PENDING ) ) == 0 ) {
+                if( _state.compare_exchange_weak( state, state + 1 ) ) {
+                    return;
+                }
+
+                continue;
+            }
+
+            if( i < COUNT_SPIN ) {
+                _pause();
+            } else {
+                _park( state );
+            }
+
+            state = _state;
+        }
+    }
+
+    void RWLock::unlock_shared() {
+        auto state = _state.fetch_sub( 1 ) - 1;
+
+        if( ( state & MASK_READERS ) == 0 && ( state & MASK_PENDING ) != 0 ) {
+            _wake();
+        }
+    }
+}
+
+#endif
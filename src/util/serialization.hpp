@@ -3,7 +3,6 @@
 
 #include <string.h>
 #include <arpa/inet.h>
-#include <memory>
 
 #define htonll(x) ((1==htonl(1)) ? (x) : (((uint64_t)htonl((x) & 0xfffffffful)) << 32) | htonl((uint32_t)((x) >> 32)))
 #define ntohll(x) ((1==ntohl(1)) ? (x) : (((uint64_t)ntohl((x) & 0xfffffffful)) << 32) | ntohl((uint32_t)((x) >> 32)))
@@ -33,12 +32,13 @@ namespace memsess::util {
             };
 
 
-            static std::unique_ptr<char[]> pack( const Item **items, unsigned int &resultLength );
+            static unsigned int getLength( const Item **items );
+            static void pack( const Item **items, char *data );
             static bool unpack( Item **items, const char *data, unsigned int length );
     };
 
-    std::unique_ptr<char[]> Serialization::pack( const Item **items, unsigned int &resultLength ) {
-        resultLength = 0;
+    unsigned int Serialization::getLength( const Item **items ) {
+        unsigned int resultLength = 0;
 
         for( unsigned int i = 0; items[i]->type != END; i++ ) {
             auto item = items[i];
@@ -65,16 +65,21 @@ namespace memsess::util {
                 case LONG_INT:
                     resultLength += sizeof( long int );
                     break;
+                case END:
+                    break;
             }
         }
 
+        return resultLength;
+    }
+
+    void Serialization::pack( const Item **items, char *data ) {
         unsigned int offset = 0;
         unsigned int length = 0;
         int value_int = 0;
         long int value_long_int = 0;
         short int value_short_int = 0;
         char null = 0;
-        auto data = std::make_unique<char[]>(resultLength);
 
         for( unsigned int i = 0; items[i]->type != END; i++ ) {
             auto item = items[i];
@@ -122,10 +127,11 @@ namespace memsess::util {
                     value_long_int = htonll( item->value_long_int );
                     memcpy( &data[offset], &value_long_int, sizeof( long int ) );
                     offset += sizeof( long int );
+                    break;
+                case END:
+                    break;
             }
         }
-
-        return data;
     }
 
     bool Serialization::unpack( Item **items, const char *data, unsigned int length ) {
@@ -219,6 +225,8 @@ namespace memsess::util {
                     item->value_long_int = ntohll( value_long_int );
                     offset += sizeof( long int );
                     break;
+                case END:
+                    break;
             }
         }
 
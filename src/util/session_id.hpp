@@ -0,0 +1,67 @@
+#ifndef MEMSESS_UTIL_SESSION_ID
+#define MEMSESS_UTIL_SESSION_ID
+
+#include <string.h>
+#include <cstddef>
+#include <random>
+#include "uuid.hpp"
+
+namespace memsess::util {
+    struct SessionId {
+        unsigned long int high;
+        unsigned long int low;
+
+        struct Hash {
+            static unsigned long int getSeed();
+            static inline const unsigned long int seedHigh = getSeed();
+            static inline const unsigned long int seedLow = getSeed();
+
+            std::size_t operator()( const SessionId &id ) const;
+        };
+
+        static SessionId fromRaw( const char *data );
+        static SessionId generate();
+        void toRaw( char *data ) const;
+        bool operator==( const SessionId &id ) const;
+    };
+
+    unsigned long int SessionId::Hash::getSeed() {
+        std::random_device rd;
+
+        return ( ( unsigned long int )rd() << 32 ) | rd() | 1;
+    }
+
+    std::size_t SessionId::Hash::operator()( const SessionId &id ) const {
+        auto result = ( unsigned __int128 )( id.high ^ seedHigh ) * ( id.low ^ seedLow );
+
+        return ( unsigned long int )( result >> 64 ) ^ ( unsigned long int )result;
+    }
+
+    SessionId SessionId::fromRaw( const char *data ) {
+        SessionId id;
+
+        memcpy( &id.high, data, sizeof( id.high ) );
+        memcpy( &id.low, &data[sizeof( id.high )], sizeof( id.low ) );
+
+        return id;
+    }
+
+    SessionId SessionId::generate() {
+        char data[UUID::LENGTH_RAW];
+
+        UUID::generateRaw( data );
+
+        return fromRaw( data );
+    }
+
+    void SessionId::toRaw( char *data ) const {
+        memcpy( data, &high, sizeof( high ) );
+        memcpy( &data[sizeof( high )], &low, sizeof( low ) );
+    }
+
+    bool SessionId::operator==( const SessionId &id ) const {
+        return high == id.high && low == id.low;
+    }
+}
+
+#endif
@@ -0,0 +1,325 @@
+#ifndef MEMSESS_UTIL_SLAB
+#define MEMSESS_UTIL_SLAB
+
+#include <stdlib.h>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <new>
+#include <sys/mman.h>
+#include "allocations.hpp"
+
+#include <mutex>
+
+namespace memsess::util {
+    template<typename Policy>
+    class Slab {
+        public:
+            struct Stat {
+                unsigned int size;
+                unsigned long int slabs;
+                unsigned long int bytesLive;
+                unsigned long int bytesWasted;
+            };
+
+            static const unsigned long int SIZE_SLAB = 65'536;
+            static const unsigned int MAX_SIZE = 16'384;
+
+        private:
+            static const unsigned int COUNT_TRIM_SLABS = 256;
+
+            struct FreeNode {
+                FreeNode *next;
+            };
+
+            struct alignas( 16 ) Info {
+                unsigned int indexClass;
+                unsigned int live;
+                FreeNode *free;
+                Info *prev;
+                Info *next;
+            };
+
+            static const unsigned int SIZE_INFO = sizeof( Info );
+
+            struct Class {
+                unsigned int size;
+                Info *partial = nullptr;
+                char *cursor = nullptr;
+                char *end = nullptr;
+                unsigned long int slabs = 0;
+                unsigned long int bytesLive = 0;
+            };
+
+            struct SlabRef {
+                char *ptr;
+                bool isReleased;
+            };
+
+            std::unique_ptr<Class[]> _classes;
+            std::vector<SlabRef> _slabs;
+            std::vector<unsigned long int> _slabsReleased;
+            unsigned long int _indexTrim = 0;
+            unsigned int _countClasses = 0;
+            unsigned long int _bytesLarge = 0;
+            typename Policy::Mutex _m;
+
+            unsigned int _getIndexClass( unsigned int size );
+            static char *_getSlab( void *ptr );
+            static Info *_getInfo( void *ptr );
+            static void _link( Class *cls, Info *info );
+            static void _unlink( Class *cls, Info *info );
+
+        public:
+            Slab();
+            ~Slab();
+            void *allocate( unsigned int size );
+            void free( void *ptr, unsigned int size );
+            unsigned long int trim();
+            void getStats( std::vector<Stat> &stats );
+            static std::vector<unsigned int> getSizes();
+
+            template<typename T, typename... Args>
+            T *create( Args&&... args );
+
+            template<typename T>
+            void destroy( T *ptr );
+    };
+
+    template<typename Policy>
+    std::vector<unsigned int> Slab<Policy>::getSizes() {
+        std::vector<unsigned int> sizes;
+
+        for( unsigned int size = 16; size <= 128; size += 16 ) {
+            sizes.push_back( size );
+        }
+
+        for( unsigned int base = 128; base < MAX_SIZE; base *= 2 ) {
+            for( unsigned int i = 1; i <= 4; i++ ) {
+                sizes.push_back( base + base / 4 * i );
+            }
+        }
+
+        return sizes;
+    }
+
+    template<typename Policy>
+    Slab<Policy>::Slab() {
+        auto sizes = getSizes();
+
+        _countClasses = sizes.size();
+        _classes = std::make_unique<Class[]>( _countClasses );
+
+        for( unsigned int i = 0; i < _countClasses; i++ ) {
+            _classes[i].size = sizes[i];
+        }
+    }
+
+    template<typename Policy>
+    Slab<Policy>::~Slab() {
+        for( auto &slab : _slabs ) {
+            ::free( slab.ptr );
+        }
+    }
+
+    template<typename Policy>
+    unsigned int Slab<Policy>::_getIndexClass( unsigned int size ) {
+        if( size <= 128 ) {
+            return size == 0 ? 0 : ( size - 1 ) / 16;
+        }
+
+        unsigned int index = 8;
+
+        while( _classes[index].size < size ) {
+            index++;
+        }
+
+        return index;
+    }
+
+    template<typename Policy>
+    char *Slab<Policy>::_getSlab( void *ptr ) {
+        return ( char * )( ( unsigned long int )ptr & ~( SIZE_SLAB - 1 ) );
+    }
+
+    template<typename Policy>
+    typename Slab<Policy>::Info *Slab<Policy>::_getInfo( void *ptr ) {
+        return ( Info * )_getSlab( ptr );
+    }
+
+    template<typename Policy>
+    void Slab<Policy>::_link( Class *cls, Info *info ) {
+        info->prev = nullptr;
+        info->next = cls->partial;
+
+        if( cls->partial != nullptr ) {
+            cls->partial->prev = info;
+        }
+
+        cls->partial = info;
+    }
+
+    template<typename Policy>
+    void Slab<Policy>::_unlink( Class *cls, Info *info ) {
+        if( info->prev != nullptr ) {
+            info->prev->next = info->next;
+        } else {
+            cls->partial = info->next;
+        }
+
+        if( info->next != nullptr ) {
+            info->next->prev = info->prev;
+        }
+    }
+
+    template<typename Policy>
+    void *Slab<Policy>::allocate( unsigned int size ) {
+        std::lock_guard<typename Policy::Mutex> lock( _m );
+
+        if( size > MAX_SIZE ) {
+            _bytesLarge += size;
+            return Allocations::malloc( size );
+        }
+
+        auto indexClass = _getIndexClass( size );
+        auto cls = &_classes[indexClass];
+        cls->bytesLive += size;
+
+        if( cls->partial != nullptr ) {
+            auto info = cls->partial;
+            auto node = info->free;
+
+            info->free = node->next;
+            info->live++;
+
+            if( info->free == nullptr ) {
+                _unlink( cls, info );
+            }
+
+            return node;
+        }
+
+        if( cls->cursor == nullptr || cls->cursor + cls->size > cls->end ) {
+            char *slab;
+
+            if( !_slabsReleased.empty() ) {
+                auto ref = &_slabs[_slabsReleased.back()];
+
+                _slabsReleased.pop_back();
+                ref->isReleased = false;
+                slab = ref->ptr;
+            } else {
+                slab = ( char * )Allocations::alignedAlloc( SIZE_SLAB, SIZE_SLAB );
+                _slabs.push_back( SlabRef{ slab, false } );
+            }
+
+            new ( slab ) Info{ indexClass, 0, nullptr, nullptr, nullptr };
+            cls->slabs++;
+            cls->cursor = slab + SIZE_INFO;
+            cls->end = slab + SIZE_SLAB;
+        }
+
+        auto ptr = cls->cursor;
+        cls->cursor += cls->size;
+        _getInfo( ptr )->live++;
+
+        return ptr;
+    }
+
+    template<typename Policy>
+    void Slab<Policy>::free( void *ptr, unsigned int size ) {
+        std::lock_guard<typename Policy::Mutex> lock( _m );
+
+        if( size > MAX_SIZE ) {
+            _bytesLarge -= size;
+            ::free( ptr );
+            return;
+        }
+
+        auto cls = &_classes[_getIndexClass( size )];
+        auto info = _getInfo( ptr );
+        auto node = ( FreeNode * )ptr;
+
+        if( info->free == nullptr ) {
+            _link( cls, info );
+        }
+
+        cls->bytesLive -= size;
+        node->next = info->free;
+        info->free = node;
+        info->live--;
+    }
+
+    template<typename Policy>
+    unsigned long int Slab<Policy>::trim() {
+        std::lock_guard<typename Policy::Mutex> lock( _m );
+        unsigned long int bytes = 0;
+
+        for( unsigned int i = 0; i < COUNT_TRIM_SLABS && i < _slabs.size(); i++ ) {
+            if( _indexTrim >= _slabs.size() ) {
+                _indexTrim = 0;
+            }
+
+            auto index = _indexTrim++;
+            auto ref = &_slabs[index];
+
+            if( ref->isReleased ) {
+                continue;
+            }
+
+            auto info = _getInfo( ref->ptr );
+            auto cls = &_classes[info->indexClass];
+
+            if( info->live != 0 || cls->end == ref->ptr + SIZE_SLAB ) {
+                continue;
+            }
+
+            _unlink( cls, info );
+            cls->slabs--;
+            madvise( ref->ptr, SIZE_SLAB, MADV_DONTNEED );
+            ref->isReleased = true;
+            _slabsReleased.push_back( index );
+            bytes += SIZE_SLAB;
+        }
+
+        return bytes;
+    }
+
+    template<typename Policy>
+    void Slab<Policy>::getStats( std::vector<Stat> &stats ) {
+        std::lock_guard<typename Policy::Mutex> lock( _m );
+
+        if( stats.size() != _countClasses + 1 ) {
+            stats.assign( _countClasses + 1, Stat{} );
+
+            for( unsigned int i = 0; i < _countClasses; i++ ) {
+                stats[i].size = _classes[i].size;
+            }
+        }
+
+        for( unsigned int i = 0; i < _countClasses; i++ ) {
+            auto cls = &_classes[i];
+
+            stats[i].slabs += cls->slabs;
+            stats[i].bytesLive += cls->bytesLive;
+            stats[i].bytesWasted += cls->slabs * SIZE_SLAB - cls->bytesLive;
+        }
+
+        stats[_countClasses].bytesLive += _bytesLarge;
+    }
+
+    template<typename Policy>
+    template<typename T, typename... Args>
+    T *Slab<Policy>::create( Args&&... args ) {
+        return new ( allocate( sizeof( T ) ) ) T( std::forward<Args>( args )... );
+    }
+
+    template<typename Policy>
+    template<typename T>
+    void Slab<Policy>::destroy( T *ptr ) {
+        ptr->~T();
+        free( ptr, sizeof( T ) );
+    }
+}
+
+#endif
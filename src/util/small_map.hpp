@@ -0,0 +1,208 @@
+#ifndef MEMSESS_UTIL_SMALL_MAP
+#define MEMSESS_UTIL_SMALL_MAP
+
+#include <atomic>
+#include <string.h>
+#include "flat_map.hpp"
+
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
+namespace memsess::util {
+    template<typename Value, typename Hash, typename KeyOf, unsigned int SIZE = 8>
+    class SmallMap {
+        static_assert( SIZE % 4 == 0 && SIZE <= 32 );
+
+        private:
+            static const unsigned int EMPTY = ~0U;
+
+            typedef FlatMap<unsigned int, Value, Hash, KeyOf> Map;
+
+            unsigned int _keys[SIZE];
+            std::atomic<Value> _values[SIZE];
+            std::atomic<Map *> _map{nullptr};
+            KeyOf _keyOf;
+
+            unsigned int _match( unsigned int key );
+            void _grow();
+
+        public:
+            SmallMap();
+            ~SmallMap();
+            SmallMap( const SmallMap & ) = delete;
+            SmallMap &operator=( const SmallMap & ) = delete;
+
+            Value find( unsigned int key );
+            bool insert( Value value );
+            Value erase( unsigned int key );
+
+            unsigned long int capacity();
+            unsigned long int getBytes();
+            bool isFull( unsigned long int index );
+            Value getValue( unsigned long int index );
+    };
+
+    template<typename Value, typename Hash, typename KeyOf, unsigned int SIZE>
+    SmallMap<Value, Hash, KeyOf, SIZE>::SmallMap() {
+        memset( _keys, 0xFF, sizeof( _keys ) );
+
+        for( unsigned int i = 0; i < SIZE; i++ ) {
+            _values[i].store( nullptr, std::memory_order_relaxed );
+        }
+    }
+
+    template<typename Value, typename Hash, typename KeyOf, unsigned int SIZE>
+    SmallMap<Value, Hash, KeyOf, SIZE>::~SmallMap() {
+        delete _map.load();
+    }
+
+    template<typename Value, typename Hash, typename KeyOf, unsigned int SIZE>
+    unsigned int SmallMap<Value, Hash, KeyOf, SIZE>::_match( unsigned int key ) {
+        unsigned int mask = 0;
+
+#if defined( __SSE2__ )
+        auto needle = _mm_set1_epi32( key );
+
+        for( unsigned int i = 0; i < SIZE; i += 4 ) {
+            auto group = _mm_loadu_si128( ( const __m128i * )&_keys[i] );
+            auto bits = _mm_movemask_ps( _mm_castsi128_ps( _mm_cmpeq_epi32( group, needle ) ) );
+
+            mask |= bits << i;
+        }
+#else
+        for( unsigned int i = 0; i < SIZE; i++ ) {
+            if( _keys[i] == key ) {
+                mask |= 1 << i;
+            }
+        }
+#endif
+
+        return mask;
+    }
+
+    template<typename Value, typename Hash, typename KeyOf, unsigned int SIZE>
+    void SmallMap<Value, Hash, KeyOf, SIZE>::_grow() {
+        auto map = new Map( SIZE + 1 );
+
+        for( unsigned int i = 0; i < SIZE; i++ ) {
+            auto value = _values[i].load( std::memory_order_relaxed );
+
+            if( value != nullptr ) {
+                map->insert( value );
+            }
+        }
+
+        _map.store( map, std::memory_order_release );
+    }
+
+    template<typename Value, typename Hash, typename KeyOf, unsigned int SIZE>
+    Value SmallMap<Value, Hash, KeyOf, SIZE>::find( unsigned int key ) {
+        auto map = _map.load( std::memory_order_acquire );
+
+        if( map != nullptr ) {
+            return map->find( key );
+        }
+
+        if( key == EMPTY ) {
+            return nullptr;
+        }
+
+        for( auto mask = _match( key ); mask != 0; mask &= mask - 1 ) {
+            auto value = _values[__builtin_ctz( mask )].load( std::memory_order_acquire );
+
+            if( value != nullptr && _keyOf( value ) == key ) {
+                return value;
+            }
+        }
+
+        return nullptr;
+    }
+
+    template<typename Value, typename Hash, typename KeyOf, unsigned int SIZE>
+    bool SmallMap<Value, Hash, KeyOf, SIZE>::insert( Value value ) {
+        auto map = _map.load( std::memory_order_relaxed );
+
+        if( map != nullptr ) {
+            return map->insert( value );
+        }
+
+        auto key = _keyOf( value );
+
+        if( find( key ) != nullptr ) {
+            return false;
+        }
+
+        auto mask = _match( EMPTY );
+
+        if( mask == 0 ) {
+            _grow();
+
+            return _map.load( std::memory_order_relaxed )->insert( value );
+        }
+
+        auto index = __builtin_ctz( mask );
+
+        _values[index].store( value, std::memory_order_release );
+        __atomic_store_n( &_keys[index], key, __ATOMIC_RELEASE );
+
+        return true;
+    }
+
+    template<typename Value, typename Hash, typename KeyOf, unsigned int SIZE>
+    Value SmallMap<Value, Hash, KeyOf, SIZE>::erase( unsigned int key ) {
+        auto map = _map.load( std::memory_order_relaxed );
+
+        if( map != nullptr ) {
+            return map->erase( key );
+        }
+
+        if( key == EMPTY ) {
+            return nullptr;
+        }
+
+        for( auto mask = _match( key ); mask != 0; mask &= mask - 1 ) {
+            auto index = __builtin_ctz( mask );
+            auto value = _values[index].load( std::memory_order_relaxed );
+
+            if( value != nullptr && _keyOf( value ) == key ) {
+                _values[index].store( nullptr, std::memory_order_release );
+                __atomic_store_n( &_keys[index], EMPTY, __ATOMIC_RELEASE );
+
+                return value;
+            }
+        }
+
+        return nullptr;
+    }
+
+    template<typename Value, typename Hash, typename KeyOf, unsigned int SIZE>
+    unsigned long int SmallMap<Value, Hash, KeyOf, SIZE>::capacity() {
+        auto map = _map.load( std::memory_order_relaxed );
+
+        return map != nullptr ? map->capacity() : SIZE;
+    }
+
+    template<typename Value, typename Hash, typename KeyOf, unsigned int SIZE>
+    unsigned long int SmallMap<Value, Hash, KeyOf, SIZE>::getBytes() {
+        auto map = _map.load( std::memory_order_relaxed );
+
+        return map != nullptr ? sizeof( Map ) + map->getBytes() : 0;
+    }
+
+    template<typename Value, typename Hash, typename KeyOf, unsigned int SIZE>
+    bool SmallMap<Value, Hash, KeyOf, SIZE>::isFull( unsigned long int index ) {
+        auto map = _map.load( std::memory_order_relaxed );
+
+        return map != nullptr ? map->isFull( index ) : _keys[index] != EMPTY;
+    }
+
+    template<typename Value, typename Hash, typename KeyOf, unsigned int SIZE>
+    Value SmallMap<Value, Hash, KeyOf, SIZE>::getValue( unsigned long int index ) {
+        auto map = _map.load( std::memory_order_relaxed );
+
+        return map != nullptr ? map->getValue( index ) : _values[index].load( std::memory_order_relaxed );
+    }
+}
+
+#endif
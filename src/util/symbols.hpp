@@ -0,0 +1,122 @@
+#ifndef MEMSESS_UTIL_SYMBOLS
+#define MEMSESS_UTIL_SYMBOLS
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "flat_map.hpp"
+#include "epoch.hpp"
+
+namespace memsess::util {
+    template<typename Policy>
+    class Symbols {
+        public:
+            static const unsigned int NONE = ~0U;
+
+            struct Hash {
+                std::size_t operator()( unsigned int id ) const;
+            };
+
+        private:
+            struct Symbol {
+                std::string name;
+                unsigned int id;
+            };
+
+            struct SymbolKey {
+                std::string_view operator()( Symbol *symbol ) const;
+            };
+
+            FlatMap<std::string_view, Symbol *, std::hash<std::string_view>, SymbolKey> _symbols;
+            std::vector<Symbol *> _names;
+            typename Policy::Mutex _m;
+            unsigned int _count = 0;
+            unsigned int _limit = NONE;
+
+        public:
+            Symbols() = default;
+            ~Symbols();
+            Symbols( const Symbols & ) = delete;
+            Symbols &operator=( const Symbols & ) = delete;
+
+            void setLimit( unsigned int limit );
+            unsigned int find( std::string_view name );
+            unsigned int intern( std::string_view name );
+            std::string_view getName( unsigned int id );
+    };
+
+    template<typename Policy>
+    std::size_t Symbols<Policy>::Hash::operator()( unsigned int id ) const {
+        return id * 0x9E'37'79'B9'7F'4A'7C'15UL;
+    }
+
+    template<typename Policy>
+    std::string_view Symbols<Policy>::SymbolKey::operator()( Symbol *symbol ) const {
+        return symbol->name;
+    }
+
+    template<typename Policy>
+    Symbols<Policy>::~Symbols() {
+        for( unsigned long int i = 0; i < _symbols.capacity(); i++ ) {
+            if( _symbols.isFull( i ) ) {
+                delete _symbols.getValue( i );
+            }
+        }
+    }
+
+    template<typename Policy>
+    void Symbols<Policy>::setLimit( unsigned int limit ) {
+        std::lock_guard<typename Policy::Mutex> lock( _m );
+        _limit = limit;
+    }
+
+    template<typename Policy>
+    unsigned int Symbols<Policy>::find( std::string_view name ) {
+        Epoch::Guard guard;
+        auto symbol = _symbols.find( name );
+
+        return symbol == nullptr ? NONE : symbol->id;
+    }
+
+    template<typename Policy>
+    unsigned int Symbols<Policy>::intern( std::string_view name ) {
+        auto id = find( name );
+
+        if( id != NONE ) {
+            return id;
+        }
+
+        std::lock_guard<typename Policy::Mutex> lock( _m );
+        auto symbol = _symbols.find( name );
+
+        if( symbol != nullptr ) {
+            return symbol->id;
+        }
+
+        if( _count >= _limit || _count == NONE ) {
+            return NONE;
+        }
+
+        symbol = new Symbol{ std::string( name ), _count++ };
+        _symbols.insert( symbol );
+        _names.push_back( symbol );
+
+        return symbol->id;
+    }
+
+    template<typename Policy>
+    std::string_view Symbols<Policy>::getName( unsigned int id ) {
+        std::lock_guard<typename Policy::Mutex> lock( _m );
+
+        if( id >= _names.size() ) {
+            return std::string_view();
+        }
+
+        return _names[id]->name;
+    }
+}
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef MEMSESS_UTIL_TIME
+#define MEMSESS_UTIL_TIME
+
+#include <time.h>
+
+namespace memsess::util {
+    class Time {
+        public:
+            static unsigned long int getMs();
+    };
+
+    unsigned long int Time::getMs() {
+        timespec ts;
+
+        clock_gettime( CLOCK_MONOTONIC, &ts );
+
+        return ts.tv_sec * 1'000UL + ts.tv_nsec / 1'000'000;
+    }
+}
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef MEMSESS_UTIL_TIMING_WHEEL
+#define MEMSESS_UTIL_TIMING_WHEEL
+
+#include <vector>
+
+namespace memsess::util {
+    template<typename Entry>
+    class TimingWheel {
+        private:
+            static const unsigned int BITS_FIRST = 8;
+            static const unsigned int BITS_LEVEL = 6;
+            static const unsigned int COUNT_LEVELS = 5;
+            static const unsigned int SIZE_FIRST = 1 << BITS_FIRST;
+            static const unsigned int SIZE_LEVEL = 1 << BITS_LEVEL;
+            static const unsigned long int MAX_DELTA = 1UL << ( BITS_FIRST + BITS_LEVEL * ( COUNT_LEVELS - 1 ) );
+
+            struct Node {
+                unsigned long int ts;
+                Entry entry;
+            };
+
+            std::vector<Node> _first[SIZE_FIRST];
+            std::vector<Node> _levels[COUNT_LEVELS - 1][SIZE_LEVEL];
+            std::vector<Node> _due;
+            unsigned long int _now;
+            unsigned long int _size = 0;
+
+            void _place( Node &&node );
+            void _cascade( unsigned int level );
+            void _advance( unsigned long int now );
+
+        public:
+            TimingWheel( unsigned long int now = 0 );
+            void add( unsigned long int ts, const Entry &entry );
+            bool pop( unsigned long int now, Entry &entry );
+            unsigned long int size();
+    };
+
+    template<typename Entry>
+    TimingWheel<Entry>::TimingWheel( unsigned long int now ) {
+        _now = now;
+    }
+
+    template<typename Entry>
+    void TimingWheel<Entry>::_place( Node &&node ) {
+        if( node.ts <= _now ) {
+            _due.push_back( std::move( node ) );
+            return;
+        }
+
+        auto ts = node.ts;
+        auto delta = ts - _now;
+
+        if( delta >= MAX_DELTA ) {
+            ts = _now + MAX_DELTA - 1;
+            delta = MAX_DELTA - 1;
+        }
+
+        if( delta < SIZE_FIRST ) {
+            _first[ts & ( SIZE_FIRST - 1 )].push_back( std::move( node ) );
+            return;
+        }
+
+        for( unsigned int level = 0; level < COUNT_LEVELS - 1; level++ ) {
+            auto shift = BITS_FIRST + BITS_LEVEL * level;
+
+            if( delta < 1UL << ( shift + BITS_LEVEL ) ) {
+                _levels[level][( ts >> shift ) & ( SIZE_LEVEL - 1 )].push_back( std::move( node ) );
+                return;
+            }
+        }
+    }
+
+    template<typename Entry>
+    void TimingWheel<Entry>::_cascade( unsigned int level ) {
+        auto shift = BITS_FIRST + BITS_LEVEL * level;
+        auto index = ( _now >> shift ) & ( SIZE_LEVEL - 1 );
+
+        if( index == 0 && level + 1 < COUNT_LEVELS - 1 ) {
+            _cascade( level + 1 );
+        }
+
+        auto nodes = std::move( _levels[level][index] );
+        _levels[level][index].clear();
+
+        for( auto &node : nodes ) {
+            _place( std::move( node ) );
+        }
+    }
+
+    template<typename Entry>
+    void TimingWheel<Entry>::_advance( unsigned long int now ) {
+        if( _size == _due.size() ) {
+            if( now > _now ) {
+                _now = now;
+            }
+
+            return;
+        }
+
+        while( _now < now ) {
+            _now++;
+
+            auto index = _now & ( SIZE_FIRST - 1 );
+
+            if( index == 0 ) {
+                _cascade( 0 );
+            }
+
+            auto &slot = _first[index];
+
+            for( auto &node : slot ) {
+                _due.push_back( std::move( node ) );
+            }
+
+            slot.clear();
+        }
+    }
+
+    template<typename Entry>
+    void TimingWheel<Entry>::add( unsigned long int ts, const Entry &entry ) {
+        _place( Node{ ts, entry } );
+        _size++;
+    }
+
+    template<typename Entry>
+    bool TimingWheel<Entry>::pop( unsigned long int now, Entry &entry ) {
+        if( _due.empty() ) {
+            _advance( now );
+        }
+
+        if( _due.empty() ) {
+            return false;
+        }
+
+        entry = std::move( _due.back().entry );
+        _due.pop_back();
+        _size--;
+
+        return true;
+    }
+
+    template<typename Entry>
+    unsigned long int TimingWheel<Entry>::size() {
+        return _size;
+    }
+}
+
+#endif
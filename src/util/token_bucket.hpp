@@ -0,0 +1,70 @@
+#ifndef MEMSESS_UTIL_TOKEN_BUCKET
+#define MEMSESS_UTIL_TOKEN_BUCKET
+
+namespace memsess::util {
+    template<typename Policy>
+    class TokenBucket {
+        private:
+            static const unsigned int BITS_TAT = 48;
+            static const unsigned long int MASK_TAT = ( 1UL << BITS_TAT ) - 1;
+            static const unsigned long int SCALE = 256;
+            static const unsigned long int PERIOD_MS = 1'000;
+
+            typename Policy::template Atomic<unsigned long int> _state{0};
+
+            static bool _take(
+                unsigned long int state,
+                unsigned short int limit,
+                unsigned long int ms,
+                unsigned long int &result
+            );
+
+        public:
+            bool take( unsigned short int limit, unsigned long int ms );
+    };
+
+    template<typename Policy>
+    bool TokenBucket<Policy>::_take(
+        unsigned long int state,
+        unsigned short int limit,
+        unsigned long int ms,
+        unsigned long int &result
+    ) {
+        auto interval = ( PERIOD_MS * SCALE + limit - 1 ) / limit;
+        auto cur = ms * SCALE;
+        auto tat = cur;
+
+        if( state != 0 && state >> BITS_TAT == limit && ( state & MASK_TAT ) > cur ) {
+            tat = state & MASK_TAT;
+        }
+
+        if( tat > cur + ( limit - 1 ) * interval ) {
+            return false;
+        }
+
+        result = ( ( unsigned long int )limit << BITS_TAT ) | ( tat + interval );
+
+        return true;
+    }
+
+    template<typename Policy>
+    bool TokenBucket<Policy>::take( unsigned short int limit, unsigned long int ms ) {
+        if( limit == 0 ) {
+            return true;
+        }
+
+        unsigned long int result;
+
+        auto state = _state.load( std::memory_order_relaxed );
+
+        do {
+            if( !_take( state, limit, ms, result ) ) {
+                return false;
+            }
+        } while( !_state.compare_exchange_weak( state, result, std::memory_order_relaxed ) );
+
+        return true;
+    }
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define MEMSESS_UTIL_UUID 
 
 #include <random>
+#include <string.h>
 
 namespace memsess::util {
     class UUID {
@@ -13,6 +14,7 @@ namespace memsess::util {
             static const unsigned int LENGTH = 36;
             static const unsigned int LENGTH_RAW = 16;
             static void generate( char *data );
+            static void generateRaw( char *data );
             static bool toBin( const char *data, char *resultData );
             static bool toNormal( const char *data, char *resultData );
     };
@@ -28,12 +30,12 @@ namespace memsess::util {
     }
 
     void UUID::generate( char *data ) {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        static std::uniform_int_distribution<> dis(0, 15);
-        static std::uniform_int_distribution<> dis2(8, 11);
+        static thread_local std::random_device rd;
+        static thread_local std::mt19937 gen(rd());
+        static thread_local std::uniform_int_distribution<> dis(0, 15);
+        static thread_local std::uniform_int_distribution<> dis2(8, 11);
 
-        for (int i = 0; i < LENGTH; i++) {
+        for (unsigned int i = 0; i < LENGTH; i++) {
             if( i == 8 || i == 13 || i == 18 || i == 23 ) {
                 data[i] = '-';
             } else if( i == 14 ) {
@@ -46,6 +48,19 @@ namespace memsess::util {
         }
     }
 
+    void UUID::generateRaw( char *data ) {
+        static thread_local std::random_device rd;
+        static thread_local std::mt19937_64 gen( ( ( unsigned long int )rd() << 32 ) | rd() );
+
+        for( unsigned int i = 0; i < LENGTH_RAW; i += sizeof( unsigned long int ) ) {
+            auto value = gen();
+            memcpy( &data[i], &value, sizeof( value ) );
+        }
+
+        data[6] = ( data[6] & 0x0F ) | 0x40;
+        data[8] = ( data[8] & 0x3F ) | 0x80;
+    }
+
     unsigned int UUID::getInt( char val ) {
         switch( val ) {
             case '0':
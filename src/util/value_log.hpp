@@ -0,0 +1,252 @@
+#ifndef MEMSESS_UTIL_VALUE_LOG
+#define MEMSESS_UTIL_VALUE_LOG
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "payload.hpp"
+
+namespace memsess::util {
+    template<typename Policy>
+    class ValueLog {
+        public:
+            static const unsigned long int SIZE_SEGMENT = 64UL << 20;
+
+        private:
+            static const unsigned long int SIZE_ALIGN = 8;
+
+            struct Segment {
+                ValueLog *log;
+                char *data;
+                unsigned long int size;
+                unsigned long int offset;
+                typename Policy::template Atomic<unsigned long int> bytesLive{0};
+                typename Policy::template Atomic<bool> isSealed{false};
+            };
+
+            std::string _path;
+            std::vector<Segment *> _segments;
+            Segment *_active = nullptr;
+            Segment *_spare = nullptr;
+            typename Policy::Mutex _m;
+            typename Policy::template Atomic<unsigned long int> _bytes{0};
+            typename Policy::template Atomic<unsigned long int> _bytesLive{0};
+
+            static unsigned long int _align( unsigned long int size );
+            Segment *_createSegment( unsigned long int size );
+            void _addSegment( Segment *segment );
+            void _releaseSegment( Segment *segment );
+            static void _free( void *ctx, void *ptr, unsigned int size );
+
+        public:
+            ValueLog() = default;
+            ~ValueLog();
+            ValueLog( const ValueLog & ) = delete;
+            ValueLog &operator=( const ValueLog & ) = delete;
+
+            bool open( const std::string &path );
+            bool isOpen();
+            Payload *append( const char *data, unsigned int length, unsigned int lengthOriginal = 0, bool isCreate = true );
+            void prepare();
+            bool isSparse( Payload *payload );
+            unsigned long int getBytes();
+            unsigned long int getBytesLive();
+    };
+
+    template<typename Policy>
+    ValueLog<Policy>::~ValueLog() {
+        for( auto segment : _segments ) {
+            munmap( segment->data, segment->size );
+            delete segment;
+        }
+    }
+
+    template<typename Policy>
+    unsigned long int ValueLog<Policy>::_align( unsigned long int size ) {
+        return ( size + SIZE_ALIGN - 1 ) & ~( SIZE_ALIGN - 1 );
+    }
+
+    template<typename Policy>
+    typename ValueLog<Policy>::Segment *ValueLog<Policy>::_createSegment( unsigned long int size ) {
+        auto fd = ::open( _path.c_str(), O_TMPFILE | O_RDWR, 0600 );
+
+        if( fd == -1 ) {
+            return nullptr;
+        }
+
+        if( posix_fallocate( fd, 0, size ) != 0 ) {
+            ::close( fd );
+            return nullptr;
+        }
+
+        auto data = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+        ::close( fd );
+
+        if( data == MAP_FAILED ) {
+            return nullptr;
+        }
+
+        auto segment = new Segment();
+
+        segment->log = this;
+        segment->data = ( char * )data;
+        segment->size = size;
+        segment->offset = 0;
+
+        return segment;
+    }
+
+    template<typename Policy>
+    void ValueLog<Policy>::_addSegment( Segment *segment ) {
+        _segments.push_back( segment );
+        _bytes += segment->size;
+    }
+
+    template<typename Policy>
+    void ValueLog<Policy>::_releaseSegment( Segment *segment ) {
+        for( unsigned long int i = 0; i < _segments.size(); i++ ) {
+            if( _segments[i] == segment ) {
+                _segments[i] = _segments.back();
+                _segments.pop_back();
+                break;
+            }
+        }
+
+        _bytes -= segment->size;
+        munmap( segment->data, segment->size );
+        delete segment;
+    }
+
+    template<typename Policy>
+    void ValueLog<Policy>::_free( void *ctx, void *, unsigned int size ) {
+        auto segment = ( Segment * )ctx;
+        auto log = segment->log;
+        auto bytes = _align( size );
+
+        std::lock_guard<typename Policy::Mutex> lock( log->_m );
+
+        log->_bytesLive -= bytes;
+
+        if( segment->bytesLive.fetch_sub( bytes ) == bytes && segment->isSealed ) {
+            log->_releaseSegment( segment );
+        }
+    }
+
+    template<typename Policy>
+    bool ValueLog<Policy>::open( const std::string &path ) {
+        _path = path;
+
+        auto segment = _createSegment( SIZE_SEGMENT );
+
+        if( segment == nullptr ) {
+            _path.clear();
+            return false;
+        }
+
+        _addSegment( segment );
+        _active = segment;
+
+        return true;
+    }
+
+    template<typename Policy>
+    bool ValueLog<Policy>::isOpen() {
+        return _active != nullptr;
+    }
+
+    template<typename Policy>
+    Payload *ValueLog<Policy>::append( const char *data, unsigned int length, unsigned int lengthOriginal, bool isCreate ) {
+        auto size = _align( Payload::getSize( length ) );
+
+        std::lock_guard<typename Policy::Mutex> lock( _m );
+
+        if( _active == nullptr ) {
+            return nullptr;
+        }
+
+        if( _active->offset + size > _active->size ) {
+            Segment *segment = nullptr;
+
+            if( _spare != nullptr && size <= _spare->size ) {
+                segment = _spare;
+                _spare = nullptr;
+            } else if( isCreate ) {
+                segment = _createSegment( size > SIZE_SEGMENT ? ( size + 4'095 ) & ~4'095UL : SIZE_SEGMENT );
+
+                if( segment != nullptr ) {
+                    _addSegment( segment );
+                }
+            }
+
+            if( segment == nullptr ) {
+                return nullptr;
+            }
+
+            _active->isSealed = true;
+
+            if( _active->bytesLive == 0 ) {
+                _releaseSegment( _active );
+            }
+
+            _active = segment;
+        }
+
+        auto ptr = _active->data + _active->offset;
+
+        _active->offset += size;
+        _active->bytesLive += size;
+        _bytesLive += size;
+
+        return Payload::create( ptr, data, length, _free, _active, lengthOriginal );
+    }
+
+    template<typename Policy>
+    void ValueLog<Policy>::prepare() {
+        {
+            std::lock_guard<typename Policy::Mutex> lock( _m );
+
+            if( _active == nullptr || _spare != nullptr || _active->offset * 2 < _active->size ) {
+                return;
+            }
+        }
+
+        auto segment = _createSegment( SIZE_SEGMENT );
+
+        if( segment == nullptr ) {
+            return;
+        }
+
+        std::lock_guard<typename Policy::Mutex> lock( _m );
+
+        if( _spare != nullptr ) {
+            munmap( segment->data, segment->size );
+            delete segment;
+            return;
+        }
+
+        _addSegment( segment );
+        _spare = segment;
+    }
+
+    template<typename Policy>
+    bool ValueLog<Policy>::isSparse( Payload *payload ) {
+        auto segment = ( Segment * )payload->getContext();
+
+        return segment->isSealed && segment->bytesLive * 2 < segment->offset;
+    }
+
+    template<typename Policy>
+    unsigned long int ValueLog<Policy>::getBytes() {
+        return _bytes;
+    }
+
+    template<typename Policy>
+    unsigned long int ValueLog<Policy>::getBytesLive() {
+        return _bytesLive;
+    }
+}
+
+#endif
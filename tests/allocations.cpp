@@ -0,0 +1,148 @@
+#include "../src/util/allocations.hpp"
+#include "../src/core/server_controller.hpp"
+#include "../src/core/store.hpp"
+#include "../src/core/monitoring.hpp"
+#include "../src/util/policy.hpp"
+#include "check.hpp"
+#include <string>
+#include <vector>
+#include <cstring>
+#include <arpa/inet.h>
+
+using namespace memsess;
+
+const unsigned int COUNT_SESSIONS = 256;
+const unsigned int COUNT_ROUNDS_WARM_UP = 8;
+const unsigned int COUNT_ROUNDS = 16;
+const unsigned int LENGTH_VALUE = 100;
+const char KEY[] = "name";
+
+enum Command {
+    EXIST = 2,
+    ADD_KEY = 5,
+    GET_KEY = 6,
+    SET_KEY = 7,
+    ADD_SESSION = 18,
+};
+
+std::string packInt( unsigned int value ) {
+    value = htonl( value );
+
+    return std::string( ( const char * )&value, sizeof( value ) );
+}
+
+std::string packShort( unsigned short int value ) {
+    value = htons( value );
+
+    return std::string( ( const char * )&value, sizeof( value ) );
+}
+
+unsigned int unpackInt( const char *data ) {
+    unsigned int value;
+    memcpy( &value, data, sizeof( value ) );
+
+    return ntohl( value );
+}
+
+template<typename Policy>
+class Client {
+    private:
+        typedef core::Monitoring<Policy> Monitoring;
+        typedef core::Store<Policy, Monitoring> Store;
+        typedef core::ServerController<Store, Monitoring> Controller;
+
+        Monitoring _monitoring;
+        Store _store;
+        Controller _controller;
+        util::ByteBuffer _result;
+        util::PayloadRef _payload;
+
+    public:
+        Client();
+        const char *request( const std::string &data );
+};
+
+template<typename Policy>
+Client<Policy>::Client(): _store( &_monitoring, 4 ), _controller( &_store, &_monitoring ) {
+    _store.setLimit( 0 );
+}
+
+template<typename Policy>
+const char *Client<Policy>::request( const std::string &data ) {
+    unsigned int resultLength = 0;
+    unsigned int payloadOffset = 0;
+
+    util::Clock::update();
+    _controller.parse( data.data(), data.size(), _result, resultLength, _payload, payloadOffset );
+    _payload.reset();
+
+    return _result.getData() + sizeof( int );
+}
+
+template<typename Policy>
+void run( const char *name ) {
+    util::Epoch::setShared( Policy::IS_MULTI );
+
+    Client<Policy> client;
+    std::vector<std::string> requestsExist;
+    std::vector<std::string> requestsGet;
+    std::vector<std::string> requestsSet;
+    std::string key( KEY, sizeof( KEY ) );
+    std::string value( LENGTH_VALUE, 'v' );
+
+    for( unsigned int i = 0; i < COUNT_SESSIONS; i++ ) {
+        char uuid[util::UUID::LENGTH_RAW];
+        util::SessionId::generate().toRaw( uuid );
+        std::string id( uuid, sizeof( uuid ) );
+
+        CHECK( client.request( char( ADD_SESSION ) + id + packInt( 0 ) )[0] == 1 );
+        CHECK( client.request( char( ADD_KEY ) + id + key + packInt( value.size() ) + value + packInt( 0 ) )[0] == 1 );
+
+        requestsExist.push_back( char( EXIST ) + id );
+        requestsGet.push_back( char( GET_KEY ) + id + key + packShort( 0 ) );
+        requestsSet.push_back( char( SET_KEY ) + id + key + packInt( value.size() ) + value + packInt( 0 ) + packInt( 0 ) + packShort( 0 ) );
+    }
+
+    auto offsetCounters = requestsSet[0].size() - sizeof( short int ) - 2 * sizeof( int );
+    unsigned long int countFailed = 0;
+
+    auto rounds = [&]( unsigned int count ) {
+        for( unsigned int round = 0; round < count; round++ ) {
+            for( unsigned int i = 0; i < COUNT_SESSIONS; i++ ) {
+                countFailed += client.request( requestsExist[i] )[0] != 1;
+
+                auto response = client.request( requestsGet[i] );
+                countFailed += response[0] != 1;
+
+                memcpy( &requestsSet[i][offsetCounters], &response[1 + sizeof( int )], 2 * sizeof( int ) );
+                countFailed += client.request( requestsSet[i] )[0] != 1;
+            }
+        }
+    };
+
+    rounds( COUNT_ROUNDS_WARM_UP );
+
+    auto countAllocations = util::Allocations::getCount();
+
+    rounds( COUNT_ROUNDS );
+
+    auto countRequests = 3UL * COUNT_ROUNDS * COUNT_SESSIONS;
+
+    printf(
+        "%s: %lu requests, %lu allocations\n",
+        name,
+        countRequests,
+        util::Allocations::getCount() - countAllocations
+    );
+
+    CHECK( countFailed == 0 );
+    CHECK( util::Allocations::getCount() == countAllocations );
+    CHECK( unpackInt( &requestsSet[0][offsetCounters + sizeof( int )] ) != 0 );
+}
+
+int main() {
+    run<util::PolicyMono>( "mono" );
+    run<util::PolicyMulti>( "multi" );
+
+    return tests::Check::finish( "allocations" );
+}
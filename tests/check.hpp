@@ -0,0 +1,39 @@
+#ifndef MEMSESS_TESTS_CHECK
+#define MEMSESS_TESTS_CHECK
+
+#include <cstdio>
+
+namespace memsess::tests {
+    class Check {
+        private:
+            static unsigned int _countPassed;
+            static unsigned int _countFailed;
+
+        public:
+            static void check( bool isPassed, const char *expression, const char *file, int line );
+            static int finish( const char *name );
+    };
+
+    inline unsigned int Check::_countPassed = 0;
+    inline unsigned int Check::_countFailed = 0;
+
+    void Check::check( bool isPassed, const char *expression, const char *file, int line ) {
+        if( isPassed ) {
+            _countPassed++;
+            return;
+        }
+
+        _countFailed++;
+        printf( "%s:%d: failed %s\n", file, line, expression );
+    }
+
+    int Check::finish( const char *name ) {
+        printf( "%s: %u passed, %u failed\n", name, _countPassed, _countFailed );
+
+        return _countFailed == 0 ? 0 : 1;
+    }
+}
+
+#define CHECK( expression ) memsess::tests::Check::check( ( expression ), #expression, __FILE__, __LINE__ )
+
+#endif
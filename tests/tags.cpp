@@ -0,0 +1,118 @@
+#include "../src/core/store.hpp"
+#include "../src/core/monitoring.hpp"
+#include "../src/util/policy.hpp"
+#include "check.hpp"
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+using namespace memsess;
+
+const unsigned int COUNT_SHARDS = 4;
+const unsigned int COUNT_TAGS = 1'000;
+
+bool isSame( std::vector<util::SessionId> sessions, std::vector<util::SessionId> expected ) {
+    auto less = []( const util::SessionId &a, const util::SessionId &b ) {
+        return memcmp( &a, &b, sizeof( util::SessionId ) ) < 0;
+    };
+
+    std::sort( sessions.begin(), sessions.end(), less );
+    std::sort( expected.begin(), expected.end(), less );
+
+    return sessions == expected;
+}
+
+template<typename Policy>
+void run() {
+    typedef core::Monitoring<Policy> Monitoring;
+    typedef core::Store<Policy, Monitoring> Store;
+
+    util::Epoch::setShared( Policy::IS_MULTI );
+
+    Monitoring monitoring;
+    Store store( &monitoring, COUNT_SHARDS );
+    std::vector<util::SessionId> sessions;
+    std::vector<util::SessionId> found;
+    unsigned int count = 0;
+
+    store.setLimit( 0 );
+
+    for( unsigned int i = 0; i < 6; i++ ) {
+        sessions.push_back( util::SessionId::generate() );
+        CHECK( store.add( sessions.back() ) == Store::Result::OK );
+    }
+
+    CHECK( store.setTag( util::SessionId::generate(), "user-1" ) == Store::Result::E_SESSION_NONE );
+
+    CHECK( store.setTag( sessions[0], "user-1" ) == Store::Result::OK );
+    CHECK( store.setTag( sessions[1], "user-1" ) == Store::Result::OK );
+    CHECK( store.setTag( sessions[2], "user-1" ) == Store::Result::OK );
+    CHECK( store.setTag( sessions[3], "user-2" ) == Store::Result::OK );
+    CHECK( store.setTag( sessions[2], "user-1" ) == Store::Result::OK );
+
+    CHECK( store.listByTag( "user-1", found ) == Store::Result::OK );
+    CHECK( isSame( found, { sessions[0], sessions[1], sessions[2] } ) );
+    CHECK( store.listByTag( "user-2", found ) == Store::Result::OK );
+    CHECK( isSame( found, { sessions[3] } ) );
+    CHECK( store.listByTag( "user-3", found ) == Store::Result::OK );
+    CHECK( found.empty() );
+    CHECK( store.listByTag( "", found ) == Store::Result::OK );
+    CHECK( found.empty() );
+
+    CHECK( store.setTag( sessions[0], "user-2" ) == Store::Result::OK );
+    CHECK( store.listByTag( "user-1", found ) == Store::Result::OK );
+    CHECK( isSame( found, { sessions[1], sessions[2] } ) );
+    CHECK( store.listByTag( "user-2", found ) == Store::Result::OK );
+    CHECK( isSame( found, { sessions[0], sessions[3] } ) );
+
+    CHECK( store.setTag( sessions[1], "" ) == Store::Result::OK );
+    CHECK( store.listByTag( "user-1", found ) == Store::Result::OK );
+    CHECK( isSame( found, { sessions[2] } ) );
+
+    store.remove( sessions[2] );
+
+    CHECK( store.listByTag( "user-1", found ) == Store::Result::OK );
+    CHECK( found.empty() );
+
+    CHECK( store.setTag( sessions[4], "user-1" ) == Store::Result::OK );
+    CHECK( store.listByTag( "user-1", found ) == Store::Result::OK );
+    CHECK( isSame( found, { sessions[4] } ) );
+
+    CHECK( store.prolongByTag( "user-2", 60'000, count ) == Store::Result::OK );
+    CHECK( count == 2 );
+
+    CHECK( store.removeByTag( "user-2", count ) == Store::Result::OK );
+    CHECK( count == 2 );
+    CHECK( store.exist( sessions[0] ) == Store::Result::E_SESSION_NONE );
+    CHECK( store.exist( sessions[3] ) == Store::Result::E_SESSION_NONE );
+    CHECK( store.exist( sessions[1] ) == Store::Result::OK );
+    CHECK( store.exist( sessions[4] ) == Store::Result::OK );
+    CHECK( store.listByTag( "user-2", found ) == Store::Result::OK );
+    CHECK( found.empty() );
+
+    CHECK( store.removeByTag( "user-2", count ) == Store::Result::OK );
+    CHECK( count == 0 );
+
+    CHECK( store.setTag( sessions[5], "user-2" ) == Store::Result::OK );
+    CHECK( store.listByTag( "user-2", found ) == Store::Result::OK );
+    CHECK( isSame( found, { sessions[5] } ) );
+
+    for( unsigned int i = 0; i < COUNT_TAGS; i++ ) {
+        CHECK( store.setTag( sessions[1], "tag-" + std::to_string( i ) ) == Store::Result::OK );
+    }
+
+    CHECK( store.getKeyId( "tag-0" ) == Store::KEY_ID_NONE );
+    CHECK( store.getKeyId( "user-1" ) == Store::KEY_ID_NONE );
+    CHECK( store.listByTag( "tag-0", found ) == Store::Result::OK );
+    CHECK( found.empty() );
+    CHECK( store.listByTag( "tag-" + std::to_string( COUNT_TAGS - 1 ), found ) == Store::Result::OK );
+    CHECK( isSame( found, { sessions[1] } ) );
+}
+
+int main() {
+    run<util::PolicyMono>();
+    run<util::PolicyMulti>();
+
+    return tests::Check::finish( "tags" );
+}